@@ -6,7 +6,7 @@ CORE_DIR   := $(LOCAL_PATH)/..
 
 include $(CORE_DIR)/Makefile.common
 
-COREFLAGS := -DINLINE=inline -D__LIBRETRO__
+COREFLAGS := -DINLINE=inline -D__LIBRETRO__ -DHAVE_THREADS
 COREFLAGS += -DHAVE_CHD -DUSE_FILE32API -DHAVE_ZLIB -DZ7_ST -DZSTD_DISABLE_ASM
 COREFLAGS += -DHAVE_FLAC -DFLAC__HAS_OGG=0 -DFLAC_API_EXPORTS -DFLAC__NO_DLL
 COREFLAGS += -DHAVE_LROUND -DHAVE_STDINT_H -DHAVE_STDLIB_H -DHAVE_SYS_PARAM_H
@@ -317,6 +317,23 @@ int m68k_cycles_remaining(void);        /* Number of cycles left */
 void m68k_modify_timeslice(int cycles); /* Modify cycles left */
 void m68k_end_timeslice(void);          /* End timeslice now */
 
+/* Set a callback for the end of a timeslice.
+ * When the cycles run out inside m68k_execute(), the CPU calls this
+ * callback with the cycles the slice used - what m68k_execute() would
+ * return - and the host can do whatever it would have done between two
+ * calls.  The callback returns the cycles of the next timeslice, which
+ * the CPU goes straight on with unless a reset, a STOP or an interrupt
+ * is waiting: those are only dealt with on entry, so m68k_execute()
+ * returns instead, and the host must call it again for that slice.
+ * Returning 0 ends m68k_execute() as well.  Its return value only
+ * counts the cycles of the last slice.  Once m68k_execute() has run an
+ * instruction, every slice it runs ends with a call; it only returns
+ * without one when it has nothing to run: reset cycles to eat, or a
+ * stopped CPU.
+ * Default behavior: no callback, m68k_execute() returns.
+ */
+void m68k_set_timeslice_callback(int (*callback)(int cycles_used));
+
 /* Set the IPL0-IPL2 pins on the CPU (IRQ).
  * A transition from < 7 to 7 will cause a non-maskable interrupt (NMI).
  * Setting IRQ to 0 will clear an interrupt request.
@@ -338,6 +355,30 @@ void m68k_pulse_halt(void);
 void m68k_pulse_bus_error(void);
 
 
+/* Hand the CPU the host memory behind a page of the address space, so it
+ * can read or write it without calling out (see M68K_DIRECT_PAGES in
+ * m68kconf.h).  Only plain memory qualifies: the CPU simply indexes base
+ * with the low bits of the address.  NULL, the default, sends accesses
+ * to the page back to the m68k_read/write_memory_xx functions.
+ */
+#define M68K_PAGE_SHIFT 7
+#define M68K_PAGE_SIZE  (1 << M68K_PAGE_SHIFT)
+#define M68K_PAGE_COUNT (0x1000000 >> M68K_PAGE_SHIFT)
+
+void m68k_set_read_page(unsigned int page, const unsigned char* base);
+void m68k_set_write_page(unsigned int page, unsigned char* base);
+
+
+/* Turn the block cache on or off (see M68K_BLOCK_CACHE in m68kconf.h).
+ * Writes the CPU makes are seen by the cache; anything else that changes
+ * code in a direct page - DMA, a loader, a saved state - must report it
+ * with m68k_invalidate_code().  Handing a page a new base with
+ * m68k_set_read_page() forgets its code as well.
+ */
+void m68k_set_block_cache(int enable);
+void m68k_invalidate_code(unsigned int address, unsigned int size);
+
+
 /* Context switching to allow multiple CPUs */
 
 /* Get the size of the cpu context in bytes */
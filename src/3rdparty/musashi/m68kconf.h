@@ -168,6 +168,21 @@ int neocd_illegal_handler(int instruction);
 #define M68K_EMULATE_ADDRESS_ERROR  OPT_ON
 
 
+/* If ON, the CPU reads and writes the pages handed to it with
+ * m68k_set_read_page() and m68k_set_write_page() on its own, and only
+ * calls the m68k_read/write_memory_xx functions for the other pages.
+ */
+#define M68K_DIRECT_PAGES           OPT_ON
+
+
+/* If ON, the CPU remembers the opcodes it fetches from direct pages in
+ * short traces, and runs a trace again without fetching or decoding its
+ * opcodes for as long as nothing writes to its page.  Needs
+ * M68K_DIRECT_PAGES.  m68k_set_block_cache() turns it on at run time.
+ */
+#define M68K_BLOCK_CACHE            OPT_ON
+
+
 /* ----------------------------- COMPATIBILITY ---------------------------- */
 
 /* The following options set optimizations that violate the current ANSI
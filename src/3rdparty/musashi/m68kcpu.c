@@ -38,12 +38,12 @@
 /* ================================ INCLUDES ============================== */
 /* ======================================================================== */
 
-extern unsigned char m68ki_cycles[0x10000];
 extern void (*m68ki_instruction_jump_table[0x10000])(void); /* opcode handler jump table */
 extern void m68ki_build_opcode_table(void);
 
 #include "m68kops.h"
 #include "m68kcpu.h"
+#include <string.h>
 
 
 /* ======================================================================== */
@@ -52,12 +52,64 @@ extern void m68ki_build_opcode_table(void);
 
 int  m68ki_initial_cycles;
 int  m68ki_remaining_cycles = 0;                     /* Number of clocks remaining */
+
+/* Called when a timeslice runs out, see m68k_set_timeslice_callback().
+   Not part of m68ki_cpu, which saved states copy byte for byte. */
+static int (*m68ki_timeslice_callback)(int cycles_used) = NULL;
+
 uint m68ki_tracing = 0;
 uint m68ki_address_space;
 
 /* The CPU core */
 m68ki_cpu_core m68ki_cpu = {0};
 
+#if M68K_DIRECT_PAGES
+/* Host memory behind each page, or NULL to call out */
+const uint8* m68ki_read_pages[M68K_PAGE_COUNT];
+uint8*       m68ki_write_pages[M68K_PAGE_COUNT];
+#endif /* M68K_DIRECT_PAGES */
+
+#if M68K_BLOCK_CACHE
+/* Instructions a trace holds at most, and traces remembered at once */
+#define M68K_BLOCK_LENGTH 16
+#define M68K_BLOCK_COUNT  2048
+
+/* An odd address: no block ever starts there */
+#define M68K_BLOCK_EMPTY  1
+
+/* One instruction of a trace: where it was, and what fetching and
+   decoding its opcode there came to */
+typedef struct
+{
+	void (*handler)(void);
+	uint   pc;
+	uint16 ir;
+	uint16 cycles;
+} m68ki_block_entry;
+
+/* The instructions run from start, all within the page of start */
+typedef struct
+{
+	uint start;
+	uint count;
+	uint generation;        /* Of its page, when it was recorded */
+	m68ki_block_entry entries[M68K_BLOCK_LENGTH];
+} m68ki_block;
+
+static m68ki_block m68ki_blocks[M68K_BLOCK_COUNT];
+static int         m68ki_block_cache;
+
+static void m68ki_flush_blocks(void);
+static void m68ki_run_block(void);
+
+/* Set for a page some block was recorded in */
+uint8 m68ki_code_pages[M68K_PAGE_COUNT];
+
+/* Bumped for a page each time it is written to with its flag set, which
+   leaves every block recorded in it under an older number */
+static uint m68ki_code_generations[M68K_PAGE_COUNT];
+#endif /* M68K_BLOCK_CACHE */
+
 #if M68K_EMULATE_ADDRESS_ERROR
 #ifdef _BSD_SETJMP_H
 sigjmp_buf m68ki_aerr_trap;
@@ -187,28 +239,6 @@ const uint8 m68ki_exception_cycle_table[256] =
 	  4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4
 };
 
-const uint8 m68ki_ea_idx_cycle_table[64] =
-{
-	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-	 0, /* ..01.000 no memory indirect, base NULL             */
-	 5, /* ..01..01 memory indirect,    base NULL, outer NULL */
-	 7, /* ..01..10 memory indirect,    base NULL, outer 16   */
-	 7, /* ..01..11 memory indirect,    base NULL, outer 32   */
-	 0,  5,  7,  7,  0,  5,  7,  7,  0,  5,  7,  7,
-	 2, /* ..10.000 no memory indirect, base 16               */
-	 7, /* ..10..01 memory indirect,    base 16,   outer NULL */
-	 9, /* ..10..10 memory indirect,    base 16,   outer 16   */
-	 9, /* ..10..11 memory indirect,    base 16,   outer 32   */
-	 0,  7,  9,  9,  0,  7,  9,  9,  0,  7,  9,  9,
-	 6, /* ..11.000 no memory indirect, base 32               */
-	11, /* ..11..01 memory indirect,    base 32,   outer NULL */
-	13, /* ..11..10 memory indirect,    base 32,   outer 16   */
-	13, /* ..11..11 memory indirect,    base 32,   outer 32   */
-	 0, 11, 13, 13,  0, 11, 13, 13,  0, 11, 13, 13
-};
-
-
-
 /* ======================================================================== */
 /* =============================== CALLBACKS ============================== */
 /* ======================================================================== */
@@ -336,10 +366,7 @@ unsigned int m68k_get_reg(void* context, m68k_register_t regnum)
 		case M68K_REG_PREF_DATA:	return cpu->pref_data;
 		case M68K_REG_PPC:	return MASK_OUT_ABOVE_32(cpu->ppc);
 		case M68K_REG_IR:	return cpu->ir;
-		case M68K_REG_CPU_TYPE:
-			return (cpu->cpu_type == CPU_TYPE_000)
-			     ? (unsigned int)M68K_CPU_TYPE_68000
-			     : (unsigned int)M68K_CPU_TYPE_INVALID;
+		case M68K_REG_CPU_TYPE:	return M68K_CPU_TYPE_68000;
 		default:			return 0;
 	}
 	return 0;
@@ -437,25 +464,39 @@ void m68k_set_instr_hook_callback(void  (*callback)(unsigned int pc))
 }
 
 /* Set the CPU type.  There is only one: the 68000 the Neo Geo
-   carries, a Toshiba TMP68HC000 in the CD.  The argument is kept
-   so the public interface does not move. */
+   carries, a Toshiba TMP68HC000 in the CD, and everything that
+   depended on the type is fixed at compile time in m68kcpu.h.  The
+   function is kept so the public interface does not move. */
 void m68k_set_cpu_type(unsigned int cpu_type)
 {
 	(void)cpu_type;
-	CPU_TYPE         = CPU_TYPE_000;
-	CPU_ADDRESS_MASK = 0x00ffffff;
-	CPU_SR_MASK      = 0xa71f; /* T1 -- S  -- -- I2 I1 I0 -- -- -- X  N  Z  V  C  */
-	CYC_INSTRUCTION  = m68ki_cycles;
-	CYC_EXCEPTION    = m68ki_exception_cycle_table;
-	CYC_BCC_NOTAKE_B = -2;
-	CYC_BCC_NOTAKE_W = 2;
-	CYC_DBCC_F_NOEXP = -2;
-	CYC_DBCC_F_EXP   = 2;
-	CYC_SCC_R_TRUE   = 2;
-	CYC_MOVEM_W      = 2;
-	CYC_MOVEM_L      = 3;
-	CYC_SHIFT        = 1;
-	CYC_RESET        = 132;
+}
+
+void m68k_set_timeslice_callback(int (*callback)(int cycles_used))
+{
+	m68ki_timeslice_callback = callback;
+}
+
+/* The timeslice has run out: ask the host for another one and go on
+   with it if entering m68k_execute() afresh would do nothing more than
+   set the cycles - no reset cycles to eat, not stopped, and no
+   interrupt to take, since those are only looked at on entry */
+static int m68ki_next_timeslice(void)
+{
+	int cycles;
+
+	if(!m68ki_timeslice_callback)
+		return 0;
+
+	cycles = m68ki_timeslice_callback(m68ki_initial_cycles - GET_CYCLES());
+	if(cycles <= 0 || RESET_CYCLES || CPU_STOPPED)
+		return 0;
+	if(m68ki_cpu.nmi_pending || CPU_INT_LEVEL > FLAG_INT_MASK)
+		return 0;
+
+	SET_CYCLES(cycles);
+	m68ki_initial_cycles = cycles;
+	return 1;
 }
 
 /* Execute some instructions until we use up num_cycles clock cycles */
@@ -486,38 +527,54 @@ int m68k_execute(int num_cycles)
 
 		m68ki_check_bus_error_trap();
 
-		/* Main loop.  Keep going until we run out of clock cycles */
-		do
+		/* Main loop.  Keep going until we run out of clock cycles, then for
+		   as long as the host hands over another timeslice */
+		for(;;)
 		{
-			int i;
-			/* Set tracing accodring to T1. (T0 is done inside instruction) */
-			m68ki_trace_t1(); /* auto-disable (see m68kcpu.h) */
+			do
+			{
+				int i;
+
+#if M68K_BLOCK_CACHE
+				if(m68ki_block_cache)
+				{
+					m68ki_run_block();
+					continue;
+				}
+#endif
 
-			/* Set the address space for reads */
-			m68ki_use_data_space(); /* auto-disable (see m68kcpu.h) */
+				/* Set tracing accodring to T1. (T0 is done inside instruction) */
+				m68ki_trace_t1(); /* auto-disable (see m68kcpu.h) */
 
-			/* Call external hook to peek at CPU */
-			m68ki_instr_hook(REG_PC); /* auto-disable (see m68kcpu.h) */
+				/* Set the address space for reads */
+				m68ki_use_data_space(); /* auto-disable (see m68kcpu.h) */
 
-			/* Record previous program counter */
-			REG_PPC = REG_PC;
+				/* Call external hook to peek at CPU */
+				m68ki_instr_hook(REG_PC); /* auto-disable (see m68kcpu.h) */
 
-			/* Record previous D/A register state (in case of bus error) */
-			for (i = 15; i >= 0; i--){
-				REG_DA_SAVE[i] = REG_DA[i];
-			}
+				/* Record previous program counter */
+				REG_PPC = REG_PC;
 
-			/* Read an instruction and call its handler */
-			REG_IR = m68ki_read_imm_16();
-			m68ki_instruction_jump_table[REG_IR]();
-			USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
+				/* Record previous D/A register state (in case of bus error) */
+				for (i = 15; i >= 0; i--){
+					REG_DA_SAVE[i] = REG_DA[i];
+				}
 
-			/* Trace m68k_exception, if necessary */
-			m68ki_exception_if_trace(); /* auto-disable (see m68kcpu.h) */
-		} while(GET_CYCLES() > 0);
+				/* Read an instruction and call its handler */
+				REG_IR = m68ki_read_imm_16();
+				m68ki_instruction_jump_table[REG_IR]();
+				USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
+
+				/* Trace m68k_exception, if necessary */
+				m68ki_exception_if_trace(); /* auto-disable (see m68kcpu.h) */
+			} while(GET_CYCLES() > 0);
+
+			/* set previous PC to current PC for the next entry into the loop */
+			REG_PPC = REG_PC;
 
-		/* set previous PC to current PC for the next entry into the loop */
-		REG_PPC = REG_PC;
+			if(!m68ki_next_timeslice())
+				break;
+		}
 	}
 	else
 		SET_CYCLES(0);
@@ -547,7 +604,8 @@ void m68k_modify_timeslice(int cycles)
 
 void m68k_end_timeslice(void)
 {
-	m68ki_initial_cycles = GET_CYCLES();
+	/* Take off what was left, so m68k_execute() returns the cycles run */
+	m68ki_initial_cycles -= GET_CYCLES();
 	SET_CYCLES(0);
 }
 
@@ -610,6 +668,10 @@ void m68k_init(void)
 	m68k_set_pc_changed_callback(NULL);
 	m68k_set_fc_callback(NULL);
 	m68k_set_instr_hook_callback(NULL);
+
+#if M68K_BLOCK_CACHE
+	m68ki_flush_blocks();
+#endif
 }
 
 /* Trigger a Bus Error exception */
@@ -618,6 +680,196 @@ void m68k_pulse_bus_error(void)
 	m68ki_exception_bus_error();
 }
 
+void m68k_set_read_page(unsigned int page, const unsigned char* base)
+{
+#if M68K_DIRECT_PAGES
+	if(m68ki_read_pages[page] != base)
+	{
+		m68ki_write_to_page(page);
+	}
+	m68ki_read_pages[page] = base;
+#else
+	(void)page;
+	(void)base;
+#endif
+}
+
+void m68k_set_write_page(unsigned int page, unsigned char* base)
+{
+#if M68K_DIRECT_PAGES
+	m68ki_write_pages[page] = base;
+#else
+	(void)page;
+	(void)base;
+#endif
+}
+
+#if M68K_BLOCK_CACHE
+
+static void m68ki_flush_blocks(void)
+{
+	uint i;
+
+	for(i = 0; i < M68K_BLOCK_COUNT; i++)
+		m68ki_blocks[i].start = M68K_BLOCK_EMPTY;
+	memset(m68ki_code_pages, 0, sizeof(m68ki_code_pages));
+}
+
+/* Forget every block recorded in a page, which has just been written to.
+   The blocks themselves are left where they are: a block only counts
+   while its generation is the page's, so this costs the same however many
+   blocks there are. */
+void m68ki_invalidate_page(uint page)
+{
+	m68ki_code_generations[page]++;
+	m68ki_code_pages[page] = 0;
+}
+
+/* Run one instruction the ordinary way, fetching and decoding its opcode.
+   The block being recorded, if any, gets an entry for it first. */
+static inline void m68ki_run_fetched(m68ki_block* block)
+{
+	int i;
+
+	m68ki_trace_t1(); /* auto-disable (see m68kcpu.h) */
+	m68ki_use_data_space(); /* auto-disable (see m68kcpu.h) */
+	m68ki_instr_hook(REG_PC); /* auto-disable (see m68kcpu.h) */
+
+	REG_PPC = REG_PC;
+	for (i = 15; i >= 0; i--){
+		REG_DA_SAVE[i] = REG_DA[i];
+	}
+
+	REG_IR = m68ki_read_imm_16();
+
+	if(block)
+	{
+		m68ki_block_entry* entry = &block->entries[block->count++];
+		entry->handler = m68ki_instruction_jump_table[REG_IR];
+		entry->pc      = REG_PPC;
+		entry->ir      = (uint16)REG_IR;
+		entry->cycles  = CYC_INSTRUCTION[REG_IR];
+	}
+
+	m68ki_instruction_jump_table[REG_IR]();
+	USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
+
+	m68ki_exception_if_trace(); /* auto-disable (see m68kcpu.h) */
+}
+
+/*
+ * Runs instructions from REG_PC until the cycles run out or the program
+ * leaves a trace.  A block recorded at this address is replayed: each of
+ * its entries runs as long as REG_PC is where that instruction was when
+ * it was recorded, with the opcode, handler and cycle cost recorded then
+ * and everything else exactly as m68k_execute() does it.  Failing that, a
+ * new block is recorded while the instructions run, if they come from a
+ * direct page; it is only kept if nothing wrote to that page meanwhile.
+ */
+static void m68ki_run_block(void)
+{
+	const uint start = REG_PC;
+	const uint page  = ADDRESS_68K(start) >> M68K_PAGE_SHIFT;
+	m68ki_block* block = &m68ki_blocks[(start >> 1) & (M68K_BLOCK_COUNT - 1)];
+
+	if(block->start == start && block->generation == m68ki_code_generations[page])
+	{
+		const m68ki_block_entry* entry = block->entries;
+		const m68ki_block_entry* end   = entry + block->count;
+		int i;
+
+		do
+		{
+			m68ki_trace_t1(); /* auto-disable (see m68kcpu.h) */
+			m68ki_use_data_space(); /* auto-disable (see m68kcpu.h) */
+			m68ki_instr_hook(REG_PC); /* auto-disable (see m68kcpu.h) */
+
+			REG_PPC = REG_PC;
+			for (i = 15; i >= 0; i--){
+				REG_DA_SAVE[i] = REG_DA[i];
+			}
+
+			/* What m68ki_read_imm_16() would have done */
+			REG_IR = entry->ir;
+			REG_PC += 2;
+
+			entry->handler();
+			USE_CYCLES(entry->cycles);
+
+			m68ki_exception_if_trace(); /* auto-disable (see m68kcpu.h) */
+			entry++;
+		} while(entry != end && GET_CYCLES() > 0 && REG_PC == entry->pc &&
+		        block->generation == m68ki_code_generations[page]);
+		return;
+	}
+
+	if((start & 1) || !m68ki_read_pages[page])
+	{
+		m68ki_run_fetched(NULL);
+		return;
+	}
+
+	block->start      = M68K_BLOCK_EMPTY;
+	block->count      = 0;
+	block->generation = m68ki_code_generations[page];
+	m68ki_code_pages[page] = 1;
+
+	do
+	{
+		m68ki_run_fetched(block);
+	} while(block->count < M68K_BLOCK_LENGTH && GET_CYCLES() > 0 &&
+	        !(REG_PC & 1) && (ADDRESS_68K(REG_PC) >> M68K_PAGE_SHIFT) == page);
+
+	/* Moved on if anything wrote to the page while the block was recorded */
+	if(block->generation == m68ki_code_generations[page])
+		block->start = start;
+}
+
+#endif /* M68K_BLOCK_CACHE */
+
+/* Writes go on forgetting blocks while the cache is off, so the blocks
+   it had are still good when it comes back on */
+void m68k_set_block_cache(int enable)
+{
+#if M68K_BLOCK_CACHE
+	m68ki_block_cache = enable;
+#else
+	(void)enable;
+#endif
+}
+
+void m68k_invalidate_code(unsigned int address, unsigned int size)
+{
+#if M68K_BLOCK_CACHE
+	uint first;
+	uint last;
+
+	if(!size)
+		return;
+
+	if(size >= 0x1000000)
+	{
+		m68ki_flush_blocks();
+		return;
+	}
+
+	first = ADDRESS_68K(address) >> M68K_PAGE_SHIFT;
+	last  = ADDRESS_68K(address + size - 1) >> M68K_PAGE_SHIFT;
+
+	for(;;)
+	{
+		m68ki_write_to_page(first);
+
+		if(first == last)
+			break;
+		first = (first + 1) & (M68K_PAGE_COUNT - 1);
+	}
+#else
+	(void)address;
+	(void)size;
+#endif
+}
+
 /* Pulse the RESET line on the CPU */
 void m68k_pulse_reset(void)
 {
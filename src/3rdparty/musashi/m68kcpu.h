@@ -326,8 +326,6 @@ typedef int32_t  int32;
 /* ------------------------------ CPU Access ------------------------------ */
 
 /* Access the CPU registers */
-#define CPU_TYPE         m68ki_cpu.cpu_type
-
 #define REG_DA           m68ki_cpu.dar /* easy access to data and address regs */
 #define REG_DA_SAVE           m68ki_cpu.dar_save
 #define REG_D            m68ki_cpu.dar
@@ -353,24 +351,29 @@ typedef int32_t  int32;
 #define CPU_STOPPED      m68ki_cpu.stopped
 #define CPU_PREF_ADDR    m68ki_cpu.pref_addr
 #define CPU_PREF_DATA    m68ki_cpu.pref_data
-#define CPU_ADDRESS_MASK m68ki_cpu.address_mask
-#define CPU_SR_MASK      m68ki_cpu.sr_mask
 #define CPU_INSTR_MODE   m68ki_cpu.instr_mode
 #define CPU_RUN_MODE     m68ki_cpu.run_mode
-
-#define CYC_INSTRUCTION  m68ki_cpu.cyc_instruction
-#define CYC_EXCEPTION    m68ki_cpu.cyc_exception
-#define CYC_BCC_NOTAKE_B m68ki_cpu.cyc_bcc_notake_b
-#define CYC_BCC_NOTAKE_W m68ki_cpu.cyc_bcc_notake_w
-#define CYC_DBCC_F_NOEXP m68ki_cpu.cyc_dbcc_f_noexp
-#define CYC_DBCC_F_EXP   m68ki_cpu.cyc_dbcc_f_exp
-#define CYC_SCC_R_TRUE   m68ki_cpu.cyc_scc_r_true
-#define CYC_MOVEM_W      m68ki_cpu.cyc_movem_w
-#define CYC_MOVEM_L      m68ki_cpu.cyc_movem_l
-#define CYC_SHIFT        m68ki_cpu.cyc_shift
-#define CYC_RESET        m68ki_cpu.cyc_reset
 #define RESET_CYCLES	 m68ki_cpu.reset_cycles
 
+/* What m68k_set_cpu_type() used to store in the CPU for each type, fixed
+   at the 68000's.  The fields they were read from stay in the struct, set
+   by nothing and read by nothing, so that saved states keep their layout. */
+#define CPU_TYPE         CPU_TYPE_000
+#define CPU_ADDRESS_MASK 0x00ffffff
+#define CPU_SR_MASK      0xa71f /* T1 -- S  -- -- I2 I1 I0 -- -- -- X  N  Z  V  C  */
+
+#define CYC_INSTRUCTION  m68ki_cycles
+#define CYC_EXCEPTION    m68ki_exception_cycle_table
+#define CYC_BCC_NOTAKE_B (-2)
+#define CYC_BCC_NOTAKE_W 2
+#define CYC_DBCC_F_NOEXP (-2)
+#define CYC_DBCC_F_EXP   2
+#define CYC_SCC_R_TRUE   2
+#define CYC_MOVEM_W      2
+#define CYC_MOVEM_L      3
+#define CYC_SHIFT        1
+#define CYC_RESET        132
+
 
 #define CALLBACK_INT_ACK     m68ki_cpu.int_ack_callback
 #define CALLBACK_BKPT_ACK    m68ki_cpu.bkpt_ack_callback
@@ -389,20 +392,6 @@ typedef int32_t  int32;
 
 /* These defines are dependant on the configuration defines in m68kconf.h */
 
-/* There is one CPU type, so every generation test is a constant. */
-#define CPU_TYPE_IS_000(A)         1
-#define CPU_TYPE_IS_010(A)         0
-#define CPU_TYPE_IS_010_PLUS(A)    0
-#define CPU_TYPE_IS_010_LESS(A)    1
-#define CPU_TYPE_IS_EC020_PLUS(A)  0
-#define CPU_TYPE_IS_EC020_LESS(A)  1
-#define CPU_TYPE_IS_020_PLUS(A)    0
-#define CPU_TYPE_IS_020_LESS(A)    1
-#define CPU_TYPE_IS_020_VARIANT(A) 0
-#define CPU_TYPE_IS_030_PLUS(A)    0
-#define CPU_TYPE_IS_030_LESS(A)    1
-#define CPU_TYPE_IS_040_PLUS(A)    0
-#define CPU_TYPE_IS_040_LESS(A)    1
 
 
 #if !M68K_SEPARATE_READS
@@ -561,6 +550,7 @@ extern sigjmp_buf m68ki_aerr_trap;
 		{ \
 			if (m68ki_remaining_cycles > 0) \
 				m68ki_remaining_cycles = 0; \
+			m68ki_next_timeslice(); \
 			return m68ki_initial_cycles; \
 		} \
 	}
@@ -582,11 +572,13 @@ extern jmp_buf m68ki_aerr_trap;
 			if(CPU_STOPPED) \
 			{ \
 				SET_CYCLES(0); \
+				m68ki_next_timeslice(); \
 				return m68ki_initial_cycles; \
 			} \
 			/* ensure we don't re-enter execution loop after an
-			   address error if there's no more cycles remaining */ \
-			if(GET_CYCLES() <= 0) \
+			   address error if there's no more cycles remaining,
+			   unless the host has handed over another timeslice */ \
+			if(GET_CYCLES() <= 0 && !m68ki_next_timeslice()) \
 			{ \
 				/* return how many clocks we used */ \
 				return m68ki_initial_cycles - GET_CYCLES(); \
@@ -604,10 +596,7 @@ extern jmp_buf m68ki_aerr_trap;
 #endif
 
 	#define m68ki_check_address_error_010_less(ADDR, WRITE_MODE, FC) \
-		if (CPU_TYPE_IS_010_LESS(CPU_TYPE)) \
-		{ \
-			m68ki_check_address_error(ADDR, WRITE_MODE, FC) \
-		}
+		m68ki_check_address_error(ADDR, WRITE_MODE, FC)
 #else
 	#define m68ki_set_address_error_trap()
 	#define m68ki_check_address_error(ADDR, WRITE_MODE, FC)
@@ -843,7 +832,7 @@ extern jmp_buf m68ki_aerr_trap;
 
 typedef struct
 {
-	uint cpu_type;     /* CPU Type: 68000, 68008, 68010, 68EC020, 68020, 68EC030, 68030, 68EC040, or 68040 */
+	uint cpu_type;     /* Unused, see CPU_TYPE */
 	uint dar[16];      /* Data and Address Registers */
 	uint dar_save[16];  /* Saved Data and Address Registers (pushed onto the
 						   stack when a bus error occurs)*/
@@ -863,13 +852,13 @@ typedef struct
 	uint stopped;      /* Stopped state */
 	uint pref_addr;    /* Last prefetch address */
 	uint pref_data;    /* Data in the prefetch queue */
-	uint address_mask; /* Available address pins */
-	uint sr_mask;      /* Implemented status register bits */
+	uint address_mask; /* Unused, see CPU_ADDRESS_MASK */
+	uint sr_mask;      /* Unused, see CPU_SR_MASK */
 	uint instr_mode;   /* Stores whether we are in instruction mode or group 0/1 exception mode */
 	uint run_mode;     /* Stores whether we are processing a reset, bus error, address error, or something else */
 	uint reset_cycles;
 
-	/* Clocks required for instructions / exceptions */
+	/* Unused, see CYC_BCC_NOTAKE_B and the rest */
 	uint cyc_bcc_notake_b;
 	uint cyc_bcc_notake_w;
 	uint cyc_dbcc_f_noexp;
@@ -884,8 +873,9 @@ typedef struct
 	uint virq_state;
 	uint nmi_pending;
 
-	const uint8* cyc_instruction;
-	const uint8* cyc_exception;
+	const uint8* cyc_instruction;  /* Unused, see CYC_INSTRUCTION; kept so
+	                                  saved states keep their layout */
+	const uint8* cyc_exception;    /* Unused, see CYC_EXCEPTION */
 
 	/* Callbacks to host */
 	int  (*int_ack_callback)(int int_line);           /* Interrupt Acknowledge */
@@ -909,13 +899,30 @@ extern const uint8    m68ki_shift_8_table[];
 extern const uint16   m68ki_shift_16_table[];
 extern const uint     m68ki_shift_32_table[];
 extern const uint8    m68ki_exception_cycle_table[256];
+extern uint8          m68ki_cycles[0x10000];
 extern uint           m68ki_address_space;
-extern const uint8    m68ki_ea_idx_cycle_table[];
 
 extern uint           m68ki_aerr_address;
 extern uint           m68ki_aerr_write_mode;
 extern uint           m68ki_aerr_fc;
 
+#if M68K_DIRECT_PAGES
+extern const uint8*   m68ki_read_pages[];
+extern uint8*         m68ki_write_pages[];
+#endif
+
+#if M68K_BLOCK_CACHE
+extern uint8          m68ki_code_pages[];
+void m68ki_invalidate_page(uint page);
+
+/* Forget the code in the page a direct write lands in */
+#define m68ki_write_to_page(P) \
+	if(m68ki_code_pages[P]) \
+		m68ki_invalidate_page(P)
+#else
+#define m68ki_write_to_page(P)
+#endif
+
 /* Forward declarations to keep some of the macros happy */
 static inline uint m68ki_read_16_fc (uint address, uint fc);
 static inline uint m68ki_read_32_fc (uint address, uint fc);
@@ -1019,6 +1026,13 @@ static inline uint m68ki_read_8_fc(uint address, uint fc)
 	(void)fc;
 	m68ki_set_fc(fc); /* auto-disable (see m68kcpu.h) */
 
+#if M68K_DIRECT_PAGES
+	{
+		const uint8* page = m68ki_read_pages[ADDRESS_68K(address) >> M68K_PAGE_SHIFT];
+		if (page)
+			return page[address & (M68K_PAGE_SIZE - 1)];
+	}
+#endif
 
 	return m68k_read_memory_8(ADDRESS_68K(address));
 }
@@ -1028,6 +1042,16 @@ static inline uint m68ki_read_16_fc(uint address, uint fc)
 	m68ki_set_fc(fc); /* auto-disable (see m68kcpu.h) */
 	m68ki_check_address_error_010_less(address, MODE_READ, fc); /* auto-disable (see m68kcpu.h) */
 
+#if M68K_DIRECT_PAGES
+	{
+		const uint8* page = m68ki_read_pages[ADDRESS_68K(address) >> M68K_PAGE_SHIFT];
+		if (page)
+		{
+			page += address & (M68K_PAGE_SIZE - 1);
+			return (page[0] << 8) | page[1];
+		}
+	}
+#endif
 
 	return m68k_read_memory_16(ADDRESS_68K(address));
 }
@@ -1037,6 +1061,19 @@ static inline uint m68ki_read_32_fc(uint address, uint fc)
 	m68ki_set_fc(fc); /* auto-disable (see m68kcpu.h) */
 	m68ki_check_address_error_010_less(address, MODE_READ, fc); /* auto-disable (see m68kcpu.h) */
 
+#if M68K_DIRECT_PAGES
+	/* One big-endian load when both words are in the same page, which
+	   compilers fold into a single load and byte swap */
+	if ((address & (M68K_PAGE_SIZE - 1)) <= M68K_PAGE_SIZE - 4)
+	{
+		const uint8* page = m68ki_read_pages[ADDRESS_68K(address) >> M68K_PAGE_SHIFT];
+		if (page)
+		{
+			page += address & (M68K_PAGE_SIZE - 1);
+			return ((uint)page[0] << 24) | ((uint)page[1] << 16) | ((uint)page[2] << 8) | page[3];
+		}
+	}
+#endif
 
 	return m68k_read_memory_32(ADDRESS_68K(address));
 }
@@ -1046,6 +1083,17 @@ static inline void m68ki_write_8_fc(uint address, uint fc, uint value)
 	(void)fc;
 	m68ki_set_fc(fc); /* auto-disable (see m68kcpu.h) */
 
+#if M68K_DIRECT_PAGES
+	{
+		uint8* page = m68ki_write_pages[ADDRESS_68K(address) >> M68K_PAGE_SHIFT];
+		if (page)
+		{
+			m68ki_write_to_page(ADDRESS_68K(address) >> M68K_PAGE_SHIFT);
+			page[address & (M68K_PAGE_SIZE - 1)] = (uint8)value;
+			return;
+		}
+	}
+#endif
 
 	m68k_write_memory_8(ADDRESS_68K(address), value);
 }
@@ -1055,6 +1103,19 @@ static inline void m68ki_write_16_fc(uint address, uint fc, uint value)
 	m68ki_set_fc(fc); /* auto-disable (see m68kcpu.h) */
 	m68ki_check_address_error_010_less(address, MODE_WRITE, fc); /* auto-disable (see m68kcpu.h) */
 
+#if M68K_DIRECT_PAGES
+	{
+		uint8* page = m68ki_write_pages[ADDRESS_68K(address) >> M68K_PAGE_SHIFT];
+		if (page)
+		{
+			m68ki_write_to_page(ADDRESS_68K(address) >> M68K_PAGE_SHIFT);
+			page += address & (M68K_PAGE_SIZE - 1);
+			page[0] = (uint8)(value >> 8);
+			page[1] = (uint8)value;
+			return;
+		}
+	}
+#endif
 
 	m68k_write_memory_16(ADDRESS_68K(address), value);
 }
@@ -1064,6 +1125,22 @@ static inline void m68ki_write_32_fc(uint address, uint fc, uint value)
 	m68ki_set_fc(fc); /* auto-disable (see m68kcpu.h) */
 	m68ki_check_address_error_010_less(address, MODE_WRITE, fc); /* auto-disable (see m68kcpu.h) */
 
+#if M68K_DIRECT_PAGES
+	if ((address & (M68K_PAGE_SIZE - 1)) <= M68K_PAGE_SIZE - 4)
+	{
+		uint8* page = m68ki_write_pages[ADDRESS_68K(address) >> M68K_PAGE_SHIFT];
+		if (page)
+		{
+			m68ki_write_to_page(ADDRESS_68K(address) >> M68K_PAGE_SHIFT);
+			page += address & (M68K_PAGE_SIZE - 1);
+			page[0] = (uint8)(value >> 24);
+			page[1] = (uint8)(value >> 16);
+			page[2] = (uint8)(value >> 8);
+			page[3] = (uint8)value;
+			return;
+		}
+	}
+#endif
 
 	m68k_write_memory_32(ADDRESS_68K(address), value);
 }
@@ -1110,106 +1187,26 @@ static inline uint m68ki_get_ea_pcix(void)
  * x x x x | BASE REG | 1 1 0 | X X X X X X       (An)
  *
  * Brief extension format:
- *  F  |  E D C   |  B  |  A 9  | 8 | 7 6 5 4 3 2 1 0
- * D/A | REGISTER | W/L | SCALE | 0 |  DISPLACEMENT
- *
- * Full extension format:
- *  F     E D C      B     A 9    8   7    6    5 4       3   2 1 0
- * D/A | REGISTER | W/L | SCALE | 1 | BS | IS | BD SIZE | 0 | I/IS
- * BASE DISPLACEMENT (0, 16, 32 bit)                (bd)
- * OUTER DISPLACEMENT (0, 16, 32 bit)               (od)
+ *  F  |  E D C   |  B  |  A 9 8  | 7 6 5 4 3 2 1 0
+ * D/A | REGISTER | W/L |    -    |  DISPLACEMENT
  *
  * D/A:     0 = Dn, 1 = An                          (Xn)
  * W/L:     0 = W (sign extend), 1 = L              (.SIZE)
- * SCALE:   00=1, 01=2, 10=4, 11=8                  (*SCALE)
- * BS:      0=add base reg, 1=suppress base reg     (An suppressed)
- * IS:      0=add index, 1=suppress index           (Xn suppressed)
- * BD SIZE: 00=reserved, 01=NULL, 10=Word, 11=Long  (size of bd)
  *
- * IS I/IS Operation
- * 0  000  No Memory Indirect
- * 0  001  indir prex with null outer
- * 0  010  indir prex with word outer
- * 0  011  indir prex with long outer
- * 0  100  reserved
- * 0  101  indir postx with null outer
- * 0  110  indir postx with word outer
- * 0  111  indir postx with long outer
- * 1  000  no memory indirect
- * 1  001  mem indir with null outer
- * 1  010  mem indir with word outer
- * 1  011  mem indir with long outer
- * 1  100-111  reserved
+ * The 68000 has only the brief format and ignores bits 8-10: the scale
+ * and the full format with its memory indirection came with the 68020.
  */
 static inline uint m68ki_get_ea_ix(uint An)
 {
 	/* An = base register */
 	uint extension = m68ki_read_imm_16();
-	uint Xn = 0;                        /* Index register */
-	uint bd = 0;                        /* Base Displacement */
-	uint od = 0;                        /* Outer Displacement */
-
-	if(CPU_TYPE_IS_010_LESS(CPU_TYPE))
-	{
-		/* Calculate index */
-		Xn = REG_DA[extension>>12];     /* Xn */
-		if(!BIT_B(extension))           /* W/L */
-			Xn = MAKE_INT_16(Xn);
-
-		/* Add base register and displacement and return */
-		return An + Xn + MAKE_INT_8(extension);
-	}
-
-	/* Brief extension format */
-	if(!BIT_8(extension))
-	{
-		/* Calculate index */
-		Xn = REG_DA[extension>>12];     /* Xn */
-		if(!BIT_B(extension))           /* W/L */
-			Xn = MAKE_INT_16(Xn);
-		/* Add scale if proper CPU type */
-		if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-			Xn <<= (extension>>9) & 3;  /* SCALE */
-
-		/* Add base register and displacement and return */
-		return An + Xn + MAKE_INT_8(extension);
-	}
-
-	/* Full extension format */
-
-	USE_CYCLES(m68ki_ea_idx_cycle_table[extension&0x3f]);
-
-	/* Check if base register is present */
-	if(BIT_7(extension))                /* BS */
-		An = 0;                         /* An */
-
-	/* Check if index is present */
-	if(!BIT_6(extension))               /* IS */
-	{
-		Xn = REG_DA[extension>>12];     /* Xn */
-		if(!BIT_B(extension))           /* W/L */
-			Xn = MAKE_INT_16(Xn);
-		Xn <<= (extension>>9) & 3;      /* SCALE */
-	}
-
-	/* Check if base displacement is present */
-	if(BIT_5(extension))                /* BD SIZE */
-		bd = BIT_4(extension) ? m68ki_read_imm_32() : (uint32)MAKE_INT_16(m68ki_read_imm_16());
-
-	/* If no indirect action, we are done */
-	if(!(extension&7))                  /* No Memory Indirect */
-		return An + bd + Xn;
+	uint Xn = REG_DA[extension>>12];    /* Xn */
 
-	/* Check if outer displacement is present */
-	if(BIT_1(extension))                /* I/IS:  od */
-		od = BIT_0(extension) ? m68ki_read_imm_32() : (uint32)MAKE_INT_16(m68ki_read_imm_16());
+	if(!BIT_B(extension))               /* W/L */
+		Xn = MAKE_INT_16(Xn);
 
-	/* Postindex */
-	if(BIT_2(extension))                /* I/IS:  0 = preindex, 1 = postindex */
-		return m68ki_read_32(An + bd) + Xn + od;
-
-	/* Preindex */
-	return m68ki_read_32(An + bd + Xn) + od;
+	/* Add base register and displacement and return */
+	return An + Xn + MAKE_INT_8(extension);
 }
 
 
@@ -1305,15 +1302,6 @@ static inline void m68ki_fake_push_32(void)
 	REG_SP = MASK_OUT_ABOVE_32(REG_SP - 4);
 }
 
-static inline void m68ki_fake_pull_16(void)
-{
-	REG_SP = MASK_OUT_ABOVE_32(REG_SP + 2);
-}
-
-static inline void m68ki_fake_pull_32(void)
-{
-	REG_SP = MASK_OUT_ABOVE_32(REG_SP + 4);
-}
 
 
 /* ----------------------------- Program Flow ----------------------------- */
@@ -1442,50 +1430,17 @@ static inline uint m68ki_init_exception(void)
 	return sr;
 }
 
-/* 3 word stack frame (68000 only) */
-static inline void m68ki_stack_frame_3word(uint pc, uint sr)
-{
-	m68ki_push_32(pc);
-	m68ki_push_16(sr);
-}
-
 /* Format 0 stack frame.
- * This is the standard stack frame for 68010+.
+ * On the 68000 this is the 3 word frame: the 68010 added the format and
+ * vector word.
  */
 static inline void m68ki_stack_frame_0000(uint pc, uint sr, uint vector)
 {
-	/* Stack a 3-word frame if we are 68000 */
-	if(CPU_TYPE == CPU_TYPE_000)
-	{
-		m68ki_stack_frame_3word(pc, sr);
-		return;
-	}
-	m68ki_push_16(vector<<2);
-	m68ki_push_32(pc);
-	m68ki_push_16(sr);
-}
-
-/* Format 1 stack frame (68020).
- * For 68020, this is the 4 word throwaway frame.
- */
-static inline void m68ki_stack_frame_0001(uint pc, uint sr, uint vector)
-{
-	m68ki_push_16(0x1000 | (vector<<2));
+	(void)vector;
 	m68ki_push_32(pc);
 	m68ki_push_16(sr);
 }
 
-/* Format 2 stack frame.
- * This is used only by 68020 for trap exceptions.
- */
-static inline void m68ki_stack_frame_0010(uint sr, uint vector)
-{
-	m68ki_push_32(REG_PPC);
-	m68ki_push_16(0x2000 | (vector<<2));
-	m68ki_push_32(REG_PC);
-	m68ki_push_16(sr);
-}
-
 
 /* Bus error stack frame (68000 only).
  */
@@ -1555,137 +1510,13 @@ static inline void m68ki_stack_frame_1000(uint pc, uint sr, uint vector)
 	m68ki_push_16(sr);
 }
 
-/* Format A stack frame (short bus fault).
- * This is used only by 68020 for bus fault and address error
- * if the error happens at an instruction boundary.
- * PC stacked is address of next instruction.
- */
-static inline void m68ki_stack_frame_1010(uint sr, uint vector, uint pc)
-{
-	/* INTERNAL REGISTER */
-	m68ki_push_16(0);
-
-	/* INTERNAL REGISTER */
-	m68ki_push_16(0);
-
-	/* DATA OUTPUT BUFFER (2 words) */
-	m68ki_push_32(0);
-
-	/* INTERNAL REGISTER */
-	m68ki_push_16(0);
-
-	/* INTERNAL REGISTER */
-	m68ki_push_16(0);
-
-	/* DATA CYCLE FAULT ADDRESS (2 words) */
-	m68ki_push_32(0);
-
-	/* INSTRUCTION PIPE STAGE B */
-	m68ki_push_16(0);
-
-	/* INSTRUCTION PIPE STAGE C */
-	m68ki_push_16(0);
-
-	/* SPECIAL STATUS REGISTER */
-	m68ki_push_16(0);
-
-	/* INTERNAL REGISTER */
-	m68ki_push_16(0);
-
-	/* 1010, VECTOR OFFSET */
-	m68ki_push_16(0xa000 | (vector<<2));
-
-	/* PROGRAM COUNTER */
-	m68ki_push_32(pc);
-
-	/* STATUS REGISTER */
-	m68ki_push_16(sr);
-}
-
-/* Format B stack frame (long bus fault).
- * This is used only by 68020 for bus fault and address error
- * if the error happens during instruction execution.
- * PC stacked is address of instruction in progress.
- */
-static inline void m68ki_stack_frame_1011(uint sr, uint vector, uint pc)
-{
-	/* INTERNAL REGISTERS (18 words) */
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-
-	/* VERSION# (4 bits), INTERNAL INFORMATION */
-	m68ki_push_16(0);
-
-	/* INTERNAL REGISTERS (3 words) */
-	m68ki_push_32(0);
-	m68ki_push_16(0);
-
-	/* DATA INTPUT BUFFER (2 words) */
-	m68ki_push_32(0);
-
-	/* INTERNAL REGISTERS (2 words) */
-	m68ki_push_32(0);
-
-	/* STAGE B ADDRESS (2 words) */
-	m68ki_push_32(0);
-
-	/* INTERNAL REGISTER (4 words) */
-	m68ki_push_32(0);
-	m68ki_push_32(0);
-
-	/* DATA OUTPUT BUFFER (2 words) */
-	m68ki_push_32(0);
-
-	/* INTERNAL REGISTER */
-	m68ki_push_16(0);
-
-	/* INTERNAL REGISTER */
-	m68ki_push_16(0);
-
-	/* DATA CYCLE FAULT ADDRESS (2 words) */
-	m68ki_push_32(0);
-
-	/* INSTRUCTION PIPE STAGE B */
-	m68ki_push_16(0);
-
-	/* INSTRUCTION PIPE STAGE C */
-	m68ki_push_16(0);
-
-	/* SPECIAL STATUS REGISTER */
-	m68ki_push_16(0);
-
-	/* INTERNAL REGISTER */
-	m68ki_push_16(0);
-
-	/* 1011, VECTOR OFFSET */
-	m68ki_push_16(0xb000 | (vector<<2));
-
-	/* PROGRAM COUNTER */
-	m68ki_push_32(pc);
-
-	/* STATUS REGISTER */
-	m68ki_push_16(sr);
-}
-
-
 /* Used for Group 2 exceptions.
- * These stack a type 2 frame on the 020.
  */
 static inline void m68ki_exception_trap(uint vector)
 {
 	uint sr = m68ki_init_exception();
 
-	if(CPU_TYPE_IS_010_LESS(CPU_TYPE))
-		m68ki_stack_frame_0000(REG_PC, sr, vector);
-	else
-		m68ki_stack_frame_0010(sr, vector);
+	m68ki_stack_frame_0000(REG_PC, sr, vector);
 
 	m68ki_jump_vector(vector);
 
@@ -1709,18 +1540,10 @@ static inline void m68ki_exception_trace(void)
 {
 	uint sr = m68ki_init_exception();
 
-	if(CPU_TYPE_IS_010_LESS(CPU_TYPE))
-	{
-		#if M68K_EMULATE_ADDRESS_ERROR == OPT_ON
-		if(CPU_TYPE_IS_000(CPU_TYPE))
-		{
-			CPU_INSTR_MODE = INSTRUCTION_NO;
-		}
-		#endif /* M68K_EMULATE_ADDRESS_ERROR */
-		m68ki_stack_frame_0000(REG_PC, sr, EXCEPTION_TRACE);
-	}
-	else
-		m68ki_stack_frame_0010(sr, EXCEPTION_TRACE);
+	#if M68K_EMULATE_ADDRESS_ERROR == OPT_ON
+	CPU_INSTR_MODE = INSTRUCTION_NO;
+	#endif /* M68K_EMULATE_ADDRESS_ERROR */
+	m68ki_stack_frame_0000(REG_PC, sr, EXCEPTION_TRACE);
 
 	m68ki_jump_vector(EXCEPTION_TRACE);
 
@@ -1737,10 +1560,7 @@ static inline void m68ki_exception_privilege_violation(void)
 	uint sr = m68ki_init_exception();
 
 	#if M68K_EMULATE_ADDRESS_ERROR == OPT_ON
-	if(CPU_TYPE_IS_000(CPU_TYPE))
-	{
-		CPU_INSTR_MODE = INSTRUCTION_NO;
-	}
+	CPU_INSTR_MODE = INSTRUCTION_NO;
 	#endif /* M68K_EMULATE_ADDRESS_ERROR */
 
 	m68ki_stack_frame_0000(REG_PPC, sr, EXCEPTION_PRIVILEGE_VIOLATION);
@@ -1829,10 +1649,7 @@ static inline void m68ki_exception_illegal(void)
 	sr = m68ki_init_exception();
 
 	#if M68K_EMULATE_ADDRESS_ERROR == OPT_ON
-	if(CPU_TYPE_IS_000(CPU_TYPE))
-	{
-		CPU_INSTR_MODE = INSTRUCTION_NO;
-	}
+	CPU_INSTR_MODE = INSTRUCTION_NO;
 	#endif /* M68K_EMULATE_ADDRESS_ERROR */
 
 	m68ki_stack_frame_0000(REG_PPC, sr, EXCEPTION_ILLEGAL_INSTRUCTION);
@@ -1842,17 +1659,6 @@ static inline void m68ki_exception_illegal(void)
 	USE_CYCLES(CYC_EXCEPTION[EXCEPTION_ILLEGAL_INSTRUCTION] - CYC_INSTRUCTION[REG_IR]);
 }
 
-/* Exception for format errror in RTE */
-static inline void m68ki_exception_format_error(void)
-{
-	uint sr = m68ki_init_exception();
-	m68ki_stack_frame_0000(REG_PC, sr, EXCEPTION_FORMAT_ERROR);
-	m68ki_jump_vector(EXCEPTION_FORMAT_ERROR);
-
-	/* Use up some clock cycles and undo the instruction's cycles */
-	USE_CYCLES(CYC_EXCEPTION[EXCEPTION_FORMAT_ERROR] - CYC_INSTRUCTION[REG_IR]);
-}
-
 /* Exception for address error */
 static inline void m68ki_exception_address_error(void)
 {
@@ -1893,10 +1699,7 @@ static inline void m68ki_exception_interrupt(uint int_level)
 	uint new_pc;
 
 	#if M68K_EMULATE_ADDRESS_ERROR == OPT_ON
-	if(CPU_TYPE_IS_000(CPU_TYPE))
-	{
-		CPU_INSTR_MODE = INSTRUCTION_NO;
-	}
+	CPU_INSTR_MODE = INSTRUCTION_NO;
 	#endif /* M68K_EMULATE_ADDRESS_ERROR */
 
 	/* Turn off the stopped state */
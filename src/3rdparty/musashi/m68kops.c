@@ -4419,398 +4419,6 @@ static void m68k_op_ble_16(void)
 }
 
 
-static void m68k_op_bhi_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_HI())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_HI())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bls_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_LS())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_LS())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bcc_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_CC())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_CC())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bcs_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_CS())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_CS())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bne_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_NE())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_NE())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_beq_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_EQ())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_EQ())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bvc_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_VC())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_VC())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bvs_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_VS())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_VS())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bpl_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_PL())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_PL())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bmi_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_MI())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_MI())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bge_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_GE())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_GE())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_blt_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_LT())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_LT())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_bgt_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_GT())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_GT())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
-static void m68k_op_ble_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		if(COND_LE())
-		{
-			uint offset = OPER_I_32();
-			REG_PC -= 4;
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_32(offset);
-			return;
-		}
-		REG_PC += 4;
-		return;
-	}
-	else
-	{
-		if(COND_LE())
-		{
-			m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-			m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-			return;
-		}
-		USE_CYCLES(CYC_BCC_NOTAKE_B);
-	}
-}
-
-
 static void m68k_op_bchg_32_r_d(void)
 {
 	uint* r_dst = &DY;
@@ -5267,28 +4875,6 @@ static void m68k_op_bra_16(void)
 }
 
 
-static void m68k_op_bra_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		uint offset = OPER_I_32();
-		REG_PC -= 4;
-		m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-		m68ki_branch_32(offset);
-		if(REG_PC == REG_PPC)
-			USE_ALL_CYCLES();
-		return;
-	}
-	else
-	{
-		m68ki_trace_t0();				   /* auto-disable (see m68kcpu.h) */
-		m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-		if(REG_PC == REG_PPC)
-			USE_ALL_CYCLES();
-	}
-}
-
-
 static void m68k_op_bset_32_r_d(void)
 {
 	uint* r_dst = &DY;
@@ -5525,26 +5111,6 @@ static void m68k_op_bsr_16(void)
 }
 
 
-static void m68k_op_bsr_32(void)
-{
-	if(CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
-	{
-		uint offset = OPER_I_32();
-		m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
-		m68ki_push_32(REG_PC);
-		REG_PC -= 4;
-		m68ki_branch_32(offset);
-		return;
-	}
-	else
-	{
-		m68ki_trace_t0();				   /* auto-disable (see m68kcpu.h) */
-		m68ki_push_32(REG_PC);
-		m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
-	}
-}
-
-
 static void m68k_op_btst_32_r_d(void)
 {
 	FLAG_Z = DY & (1 << (DX & 0x1f));
@@ -14778,96 +14344,56 @@ static void m68k_op_move_16_toc_i(void)
 
 static void m68k_op_move_16_frs_d(void)
 {
-	if(CPU_TYPE_IS_000(CPU_TYPE) || FLAG_S)	/* NS990408 */
-	{
-		DY = MASK_OUT_BELOW_16(DY) | m68ki_get_sr();
-		return;
-	}
-	m68ki_exception_privilege_violation();
+	DY = MASK_OUT_BELOW_16(DY) | m68ki_get_sr();
 }
 
 
 static void m68k_op_move_16_frs_ai(void)
 {
-	if(CPU_TYPE_IS_000(CPU_TYPE) || FLAG_S)	/* NS990408 */
-	{
-		uint ea = EA_AY_AI_16();
-		m68ki_write_16(ea, m68ki_get_sr());
-		return;
-	}
-	m68ki_exception_privilege_violation();
+	uint ea = EA_AY_AI_16();
+	m68ki_write_16(ea, m68ki_get_sr());
 }
 
 
 static void m68k_op_move_16_frs_pi(void)
 {
-	if(CPU_TYPE_IS_000(CPU_TYPE) || FLAG_S)	/* NS990408 */
-	{
-		uint ea = EA_AY_PI_16();
-		m68ki_write_16(ea, m68ki_get_sr());
-		return;
-	}
-	m68ki_exception_privilege_violation();
+	uint ea = EA_AY_PI_16();
+	m68ki_write_16(ea, m68ki_get_sr());
 }
 
 
 static void m68k_op_move_16_frs_pd(void)
 {
-	if(CPU_TYPE_IS_000(CPU_TYPE) || FLAG_S)	/* NS990408 */
-	{
-		uint ea = EA_AY_PD_16();
-		m68ki_write_16(ea, m68ki_get_sr());
-		return;
-	}
-	m68ki_exception_privilege_violation();
+	uint ea = EA_AY_PD_16();
+	m68ki_write_16(ea, m68ki_get_sr());
 }
 
 
 static void m68k_op_move_16_frs_di(void)
 {
-	if(CPU_TYPE_IS_000(CPU_TYPE) || FLAG_S)	/* NS990408 */
-	{
-		uint ea = EA_AY_DI_16();
-		m68ki_write_16(ea, m68ki_get_sr());
-		return;
-	}
-	m68ki_exception_privilege_violation();
+	uint ea = EA_AY_DI_16();
+	m68ki_write_16(ea, m68ki_get_sr());
 }
 
 
 static void m68k_op_move_16_frs_ix(void)
 {
-	if(CPU_TYPE_IS_000(CPU_TYPE) || FLAG_S)	/* NS990408 */
-	{
-		uint ea = EA_AY_IX_16();
-		m68ki_write_16(ea, m68ki_get_sr());
-		return;
-	}
-	m68ki_exception_privilege_violation();
+	uint ea = EA_AY_IX_16();
+	m68ki_write_16(ea, m68ki_get_sr());
 }
 
 
 static void m68k_op_move_16_frs_aw(void)
 {
-	if(CPU_TYPE_IS_000(CPU_TYPE) || FLAG_S)	/* NS990408 */
-	{
-		uint ea = EA_AW_16();
-		m68ki_write_16(ea, m68ki_get_sr());
-		return;
-	}
-	m68ki_exception_privilege_violation();
+	uint ea = EA_AW_16();
+	m68ki_write_16(ea, m68ki_get_sr());
 }
 
 
 static void m68k_op_move_16_frs_al(void)
 {
-	if(CPU_TYPE_IS_000(CPU_TYPE) || FLAG_S)	/* NS990408 */
-	{
-		uint ea = EA_AL_16();
-		m68ki_write_16(ea, m68ki_get_sr());
-		return;
-	}
-	m68ki_exception_privilege_violation();
+	uint ea = EA_AL_16();
+	m68ki_write_16(ea, m68ki_get_sr());
 }
 
 
@@ -19792,106 +19318,18 @@ static void m68k_op_rte_32(void)
 	{
 		uint new_sr;
 		uint new_pc;
-		uint format_word;
 
 		m68ki_rte_callback();		   /* auto-disable (see m68kcpu.h) */
 		m68ki_trace_t0();			   /* auto-disable (see m68kcpu.h) */
 
-		if(CPU_TYPE_IS_000(CPU_TYPE))
-		{
-			new_sr = m68ki_pull_16();
-			new_pc = m68ki_pull_32();
-			m68ki_jump(new_pc);
-			m68ki_set_sr(new_sr);
-
-			CPU_INSTR_MODE = INSTRUCTION_YES;
-			CPU_RUN_MODE = RUN_MODE_NORMAL;
-
-			return;
-		}
-
-		if(CPU_TYPE_IS_010(CPU_TYPE))
-		{
-			format_word = m68ki_read_16(REG_A[7]+6) >> 12;
-			if(format_word == 0)
-			{
-				new_sr = m68ki_pull_16();
-				new_pc = m68ki_pull_32();
-				m68ki_fake_pull_16();	/* format word */
-				m68ki_jump(new_pc);
-				m68ki_set_sr(new_sr);
-				CPU_INSTR_MODE = INSTRUCTION_YES;
-				CPU_RUN_MODE = RUN_MODE_NORMAL;
-				return;
-			} else if (format_word == 8) {
-				/* Format 8 stack frame -- 68010 only. 29 word bus/address error */
-				new_sr = m68ki_pull_16();
-				new_pc = m68ki_pull_32();
-				m68ki_fake_pull_16();	/* format word */
-				m68ki_fake_pull_16();	/* special status word */
-				m68ki_fake_pull_32();	/* fault address */
-				m68ki_fake_pull_16();	/* unused/reserved */
-				m68ki_fake_pull_16();	/* data output buffer */
-				m68ki_fake_pull_16();	/* unused/reserved */
-				m68ki_fake_pull_16();	/* data input buffer */
-				m68ki_fake_pull_16();	/* unused/reserved */
-				m68ki_fake_pull_16();	/* instruction input buffer */
-				m68ki_fake_pull_32();	/* internal information, 16 words */
-				m68ki_fake_pull_32();	/* (actually, we use 8 DWORDs) */
-				m68ki_fake_pull_32();
-				m68ki_fake_pull_32();
-				m68ki_fake_pull_32();
-				m68ki_fake_pull_32();
-				m68ki_fake_pull_32();
-				m68ki_fake_pull_32();
-				m68ki_jump(new_pc);
-				m68ki_set_sr(new_sr);
-				CPU_INSTR_MODE = INSTRUCTION_YES;
-				CPU_RUN_MODE = RUN_MODE_NORMAL;
-				return;
-			}
-			CPU_INSTR_MODE = INSTRUCTION_YES;
-			CPU_RUN_MODE = RUN_MODE_NORMAL;
-			/* Not handling other exception types (9) */
-			m68ki_exception_format_error();
-			return;
-		}
+		new_sr = m68ki_pull_16();
+		new_pc = m68ki_pull_32();
+		m68ki_jump(new_pc);
+		m68ki_set_sr(new_sr);
 
-		/* Otherwise it's 020 */
-rte_loop:
-		format_word = m68ki_read_16(REG_A[7]+6) >> 12;
-		switch(format_word)
-		{
-			case 0: /* Normal */
-				new_sr = m68ki_pull_16();
-				new_pc = m68ki_pull_32();
-				m68ki_fake_pull_16();	/* format word */
-				m68ki_jump(new_pc);
-				m68ki_set_sr(new_sr);
-				CPU_INSTR_MODE = INSTRUCTION_YES;
-				CPU_RUN_MODE = RUN_MODE_NORMAL;
-				return;
-			case 1: /* Throwaway */
-				new_sr = m68ki_pull_16();
-				m68ki_fake_pull_32();	/* program counter */
-				m68ki_fake_pull_16();	/* format word */
-				m68ki_set_sr_noint(new_sr);
-				goto rte_loop;
-			case 2: /* Trap */
-				new_sr = m68ki_pull_16();
-				new_pc = m68ki_pull_32();
-				m68ki_fake_pull_16();	/* format word */
-				m68ki_fake_pull_32();	/* address */
-				m68ki_jump(new_pc);
-				m68ki_set_sr(new_sr);
-				CPU_INSTR_MODE = INSTRUCTION_YES;
-				CPU_RUN_MODE = RUN_MODE_NORMAL;
-				return;
-		}
-		/* Not handling long or short bus fault */
 		CPU_INSTR_MODE = INSTRUCTION_YES;
 		CPU_RUN_MODE = RUN_MODE_NORMAL;
-		m68ki_exception_format_error();
+
 		return;
 	}
 	m68ki_exception_privilege_violation();
@@ -25501,37 +24939,21 @@ static const opcode_handler_struct m68k_opcode_handler_table[] =
 	{m68k_op_sle_8_aw        , 0xffff, 0x5ff8, 16},
 	{m68k_op_sle_8_al        , 0xffff, 0x5ff9, 20},
 	{m68k_op_bra_16          , 0xffff, 0x6000, 10},
-	{m68k_op_bra_32          , 0xffff, 0x60ff, 10},
 	{m68k_op_bsr_16          , 0xffff, 0x6100, 18},
-	{m68k_op_bsr_32          , 0xffff, 0x61ff, 18},
 	{m68k_op_bhi_16          , 0xffff, 0x6200, 10},
-	{m68k_op_bhi_32          , 0xffff, 0x62ff, 10},
 	{m68k_op_bls_16          , 0xffff, 0x6300, 10},
-	{m68k_op_bls_32          , 0xffff, 0x63ff, 10},
 	{m68k_op_bcc_16          , 0xffff, 0x6400, 10},
-	{m68k_op_bcc_32          , 0xffff, 0x64ff, 10},
 	{m68k_op_bcs_16          , 0xffff, 0x6500, 10},
-	{m68k_op_bcs_32          , 0xffff, 0x65ff, 10},
 	{m68k_op_bne_16          , 0xffff, 0x6600, 10},
-	{m68k_op_bne_32          , 0xffff, 0x66ff, 10},
 	{m68k_op_beq_16          , 0xffff, 0x6700, 10},
-	{m68k_op_beq_32          , 0xffff, 0x67ff, 10},
 	{m68k_op_bvc_16          , 0xffff, 0x6800, 10},
-	{m68k_op_bvc_32          , 0xffff, 0x68ff, 10},
 	{m68k_op_bvs_16          , 0xffff, 0x6900, 10},
-	{m68k_op_bvs_32          , 0xffff, 0x69ff, 10},
 	{m68k_op_bpl_16          , 0xffff, 0x6a00, 10},
-	{m68k_op_bpl_32          , 0xffff, 0x6aff, 10},
 	{m68k_op_bmi_16          , 0xffff, 0x6b00, 10},
-	{m68k_op_bmi_32          , 0xffff, 0x6bff, 10},
 	{m68k_op_bge_16          , 0xffff, 0x6c00, 10},
-	{m68k_op_bge_32          , 0xffff, 0x6cff, 10},
 	{m68k_op_blt_16          , 0xffff, 0x6d00, 10},
-	{m68k_op_blt_32          , 0xffff, 0x6dff, 10},
 	{m68k_op_bgt_16          , 0xffff, 0x6e00, 10},
-	{m68k_op_bgt_32          , 0xffff, 0x6eff, 10},
 	{m68k_op_ble_16          , 0xffff, 0x6f00, 10},
-	{m68k_op_ble_32          , 0xffff, 0x6fff, 10},
 	{m68k_op_sbcd_8_mm_axy7  , 0xffff, 0x8f0f, 18},
 	{m68k_op_subx_8_mm_axy7  , 0xffff, 0x9f0f, 18},
 	{m68k_op_cmpm_8_axy7     , 0xffff, 0xbf0f, 12},
@@ -105,8 +105,8 @@
 #define CALL_DEBUGGER(...)
 #define change_pc(...)
 
-#define cpu_readop		program_read_byte_8
-#define cpu_readop_arg	program_read_byte_8
+#define cpu_readop(A)		(memory_base[(A) & 0xffff])
+#define cpu_readop_arg(A)	(memory_base[(A) & 0xffff])
 
 #define VERBOSE 0
 
@@ -120,6 +120,17 @@
 #define BIG_SWITCH			1
 #endif
 
+/* dispatch every opcode, prefixed or not, by jumping through tables of */
+/* label addresses inside z80_execute (a GCC and Clang extension); off */
+/* by default, since tests/z80's make bench shows it no faster than the */
+/* big switch and the function pointer tables */
+#ifndef Z80_COMPUTED_GOTO
+#define Z80_COMPUTED_GOTO	0
+#endif
+#if Z80_COMPUTED_GOTO && !defined(__GNUC__) && !defined(__clang__)
+#error Z80_COMPUTED_GOTO needs GCC or Clang
+#endif
+
 /* big flags array for ADD/ADC/SUB/SBC/CP results */
 #define BIG_FLAGS_ARRAY		1
 
@@ -204,8 +215,12 @@ enum {
 #define HALT Z80.halt
 
 int z80_ICount;
+/* T-states the shortcuts below skipped rather than ran; the host reads and clears it */
+int z80_idle_cycles;
 Z80_Regs Z80;
 static Uint32 EA;
+/* the 64KiB the Z80 addresses are all RAM, so reads go straight to it */
+static Uint8 *memory_base;
 
 static Uint8 SZ[256];		/* zero and sign flags */
 static Uint8 SZ_BIT[256];	/* zero, sign and parity/overflow (=zero) flags for BIT opcode */
@@ -453,6 +468,7 @@ STATIC_INLINE void BURNODD(int cycles, int opcodes, int cyclesum)
 	{
 		R += (cycles / cyclesum) * opcodes;
 		z80_ICount -= (cycles / cyclesum) * cyclesum;
+		z80_idle_cycles += (cycles / cyclesum) * cyclesum;
 	}
 }
 
@@ -553,6 +569,121 @@ STATIC_INLINE void BURNODD(int cycles, int opcodes, int cyclesum)
 #define EXEC_STATIC_INLINE EXEC
 #endif
 
+#if Z80_COMPUTED_GOTO
+/***************************************************************
+ * The addresses of the labels for every opcode of a prefix,
+ * for z80_execute to jump through
+ ***************************************************************/
+#define LABELS(prefix) {	\
+	&&prefix##_l##00,&&prefix##_l##01,&&prefix##_l##02,&&prefix##_l##03,&&prefix##_l##04,&&prefix##_l##05,&&prefix##_l##06,&&prefix##_l##07, \
+	&&prefix##_l##08,&&prefix##_l##09,&&prefix##_l##0a,&&prefix##_l##0b,&&prefix##_l##0c,&&prefix##_l##0d,&&prefix##_l##0e,&&prefix##_l##0f, \
+	&&prefix##_l##10,&&prefix##_l##11,&&prefix##_l##12,&&prefix##_l##13,&&prefix##_l##14,&&prefix##_l##15,&&prefix##_l##16,&&prefix##_l##17, \
+	&&prefix##_l##18,&&prefix##_l##19,&&prefix##_l##1a,&&prefix##_l##1b,&&prefix##_l##1c,&&prefix##_l##1d,&&prefix##_l##1e,&&prefix##_l##1f, \
+	&&prefix##_l##20,&&prefix##_l##21,&&prefix##_l##22,&&prefix##_l##23,&&prefix##_l##24,&&prefix##_l##25,&&prefix##_l##26,&&prefix##_l##27, \
+	&&prefix##_l##28,&&prefix##_l##29,&&prefix##_l##2a,&&prefix##_l##2b,&&prefix##_l##2c,&&prefix##_l##2d,&&prefix##_l##2e,&&prefix##_l##2f, \
+	&&prefix##_l##30,&&prefix##_l##31,&&prefix##_l##32,&&prefix##_l##33,&&prefix##_l##34,&&prefix##_l##35,&&prefix##_l##36,&&prefix##_l##37, \
+	&&prefix##_l##38,&&prefix##_l##39,&&prefix##_l##3a,&&prefix##_l##3b,&&prefix##_l##3c,&&prefix##_l##3d,&&prefix##_l##3e,&&prefix##_l##3f, \
+	&&prefix##_l##40,&&prefix##_l##41,&&prefix##_l##42,&&prefix##_l##43,&&prefix##_l##44,&&prefix##_l##45,&&prefix##_l##46,&&prefix##_l##47, \
+	&&prefix##_l##48,&&prefix##_l##49,&&prefix##_l##4a,&&prefix##_l##4b,&&prefix##_l##4c,&&prefix##_l##4d,&&prefix##_l##4e,&&prefix##_l##4f, \
+	&&prefix##_l##50,&&prefix##_l##51,&&prefix##_l##52,&&prefix##_l##53,&&prefix##_l##54,&&prefix##_l##55,&&prefix##_l##56,&&prefix##_l##57, \
+	&&prefix##_l##58,&&prefix##_l##59,&&prefix##_l##5a,&&prefix##_l##5b,&&prefix##_l##5c,&&prefix##_l##5d,&&prefix##_l##5e,&&prefix##_l##5f, \
+	&&prefix##_l##60,&&prefix##_l##61,&&prefix##_l##62,&&prefix##_l##63,&&prefix##_l##64,&&prefix##_l##65,&&prefix##_l##66,&&prefix##_l##67, \
+	&&prefix##_l##68,&&prefix##_l##69,&&prefix##_l##6a,&&prefix##_l##6b,&&prefix##_l##6c,&&prefix##_l##6d,&&prefix##_l##6e,&&prefix##_l##6f, \
+	&&prefix##_l##70,&&prefix##_l##71,&&prefix##_l##72,&&prefix##_l##73,&&prefix##_l##74,&&prefix##_l##75,&&prefix##_l##76,&&prefix##_l##77, \
+	&&prefix##_l##78,&&prefix##_l##79,&&prefix##_l##7a,&&prefix##_l##7b,&&prefix##_l##7c,&&prefix##_l##7d,&&prefix##_l##7e,&&prefix##_l##7f, \
+	&&prefix##_l##80,&&prefix##_l##81,&&prefix##_l##82,&&prefix##_l##83,&&prefix##_l##84,&&prefix##_l##85,&&prefix##_l##86,&&prefix##_l##87, \
+	&&prefix##_l##88,&&prefix##_l##89,&&prefix##_l##8a,&&prefix##_l##8b,&&prefix##_l##8c,&&prefix##_l##8d,&&prefix##_l##8e,&&prefix##_l##8f, \
+	&&prefix##_l##90,&&prefix##_l##91,&&prefix##_l##92,&&prefix##_l##93,&&prefix##_l##94,&&prefix##_l##95,&&prefix##_l##96,&&prefix##_l##97, \
+	&&prefix##_l##98,&&prefix##_l##99,&&prefix##_l##9a,&&prefix##_l##9b,&&prefix##_l##9c,&&prefix##_l##9d,&&prefix##_l##9e,&&prefix##_l##9f, \
+	&&prefix##_l##a0,&&prefix##_l##a1,&&prefix##_l##a2,&&prefix##_l##a3,&&prefix##_l##a4,&&prefix##_l##a5,&&prefix##_l##a6,&&prefix##_l##a7, \
+	&&prefix##_l##a8,&&prefix##_l##a9,&&prefix##_l##aa,&&prefix##_l##ab,&&prefix##_l##ac,&&prefix##_l##ad,&&prefix##_l##ae,&&prefix##_l##af, \
+	&&prefix##_l##b0,&&prefix##_l##b1,&&prefix##_l##b2,&&prefix##_l##b3,&&prefix##_l##b4,&&prefix##_l##b5,&&prefix##_l##b6,&&prefix##_l##b7, \
+	&&prefix##_l##b8,&&prefix##_l##b9,&&prefix##_l##ba,&&prefix##_l##bb,&&prefix##_l##bc,&&prefix##_l##bd,&&prefix##_l##be,&&prefix##_l##bf, \
+	&&prefix##_l##c0,&&prefix##_l##c1,&&prefix##_l##c2,&&prefix##_l##c3,&&prefix##_l##c4,&&prefix##_l##c5,&&prefix##_l##c6,&&prefix##_l##c7, \
+	&&prefix##_l##c8,&&prefix##_l##c9,&&prefix##_l##ca,&&prefix##_l##cb,&&prefix##_l##cc,&&prefix##_l##cd,&&prefix##_l##ce,&&prefix##_l##cf, \
+	&&prefix##_l##d0,&&prefix##_l##d1,&&prefix##_l##d2,&&prefix##_l##d3,&&prefix##_l##d4,&&prefix##_l##d5,&&prefix##_l##d6,&&prefix##_l##d7, \
+	&&prefix##_l##d8,&&prefix##_l##d9,&&prefix##_l##da,&&prefix##_l##db,&&prefix##_l##dc,&&prefix##_l##dd,&&prefix##_l##de,&&prefix##_l##df, \
+	&&prefix##_l##e0,&&prefix##_l##e1,&&prefix##_l##e2,&&prefix##_l##e3,&&prefix##_l##e4,&&prefix##_l##e5,&&prefix##_l##e6,&&prefix##_l##e7, \
+	&&prefix##_l##e8,&&prefix##_l##e9,&&prefix##_l##ea,&&prefix##_l##eb,&&prefix##_l##ec,&&prefix##_l##ed,&&prefix##_l##ee,&&prefix##_l##ef, \
+	&&prefix##_l##f0,&&prefix##_l##f1,&&prefix##_l##f2,&&prefix##_l##f3,&&prefix##_l##f4,&&prefix##_l##f5,&&prefix##_l##f6,&&prefix##_l##f7, \
+	&&prefix##_l##f8,&&prefix##_l##f9,&&prefix##_l##fa,&&prefix##_l##fb,&&prefix##_l##fc,&&prefix##_l##fd,&&prefix##_l##fe,&&prefix##_l##ff  \
+}
+
+/***************************************************************
+ * The code for one opcode of a prefix: it takes its T-states
+ * from the table as a constant and goes on to the next opcode.
+ * Prefix opcodes are redefined below to jump on, not call.
+ ***************************************************************/
+#define HANDLER(prefix,table,opcode)	\
+	prefix##_l##opcode: z80_ICount -= cc_##table[0x##opcode]; prefix##_##opcode(); goto next;
+
+#define HANDLERS(prefix,table) \
+	HANDLER(prefix,table,00) HANDLER(prefix,table,01) HANDLER(prefix,table,02) HANDLER(prefix,table,03) \
+	HANDLER(prefix,table,04) HANDLER(prefix,table,05) HANDLER(prefix,table,06) HANDLER(prefix,table,07) \
+	HANDLER(prefix,table,08) HANDLER(prefix,table,09) HANDLER(prefix,table,0a) HANDLER(prefix,table,0b) \
+	HANDLER(prefix,table,0c) HANDLER(prefix,table,0d) HANDLER(prefix,table,0e) HANDLER(prefix,table,0f) \
+	HANDLER(prefix,table,10) HANDLER(prefix,table,11) HANDLER(prefix,table,12) HANDLER(prefix,table,13) \
+	HANDLER(prefix,table,14) HANDLER(prefix,table,15) HANDLER(prefix,table,16) HANDLER(prefix,table,17) \
+	HANDLER(prefix,table,18) HANDLER(prefix,table,19) HANDLER(prefix,table,1a) HANDLER(prefix,table,1b) \
+	HANDLER(prefix,table,1c) HANDLER(prefix,table,1d) HANDLER(prefix,table,1e) HANDLER(prefix,table,1f) \
+	HANDLER(prefix,table,20) HANDLER(prefix,table,21) HANDLER(prefix,table,22) HANDLER(prefix,table,23) \
+	HANDLER(prefix,table,24) HANDLER(prefix,table,25) HANDLER(prefix,table,26) HANDLER(prefix,table,27) \
+	HANDLER(prefix,table,28) HANDLER(prefix,table,29) HANDLER(prefix,table,2a) HANDLER(prefix,table,2b) \
+	HANDLER(prefix,table,2c) HANDLER(prefix,table,2d) HANDLER(prefix,table,2e) HANDLER(prefix,table,2f) \
+	HANDLER(prefix,table,30) HANDLER(prefix,table,31) HANDLER(prefix,table,32) HANDLER(prefix,table,33) \
+	HANDLER(prefix,table,34) HANDLER(prefix,table,35) HANDLER(prefix,table,36) HANDLER(prefix,table,37) \
+	HANDLER(prefix,table,38) HANDLER(prefix,table,39) HANDLER(prefix,table,3a) HANDLER(prefix,table,3b) \
+	HANDLER(prefix,table,3c) HANDLER(prefix,table,3d) HANDLER(prefix,table,3e) HANDLER(prefix,table,3f) \
+	HANDLER(prefix,table,40) HANDLER(prefix,table,41) HANDLER(prefix,table,42) HANDLER(prefix,table,43) \
+	HANDLER(prefix,table,44) HANDLER(prefix,table,45) HANDLER(prefix,table,46) HANDLER(prefix,table,47) \
+	HANDLER(prefix,table,48) HANDLER(prefix,table,49) HANDLER(prefix,table,4a) HANDLER(prefix,table,4b) \
+	HANDLER(prefix,table,4c) HANDLER(prefix,table,4d) HANDLER(prefix,table,4e) HANDLER(prefix,table,4f) \
+	HANDLER(prefix,table,50) HANDLER(prefix,table,51) HANDLER(prefix,table,52) HANDLER(prefix,table,53) \
+	HANDLER(prefix,table,54) HANDLER(prefix,table,55) HANDLER(prefix,table,56) HANDLER(prefix,table,57) \
+	HANDLER(prefix,table,58) HANDLER(prefix,table,59) HANDLER(prefix,table,5a) HANDLER(prefix,table,5b) \
+	HANDLER(prefix,table,5c) HANDLER(prefix,table,5d) HANDLER(prefix,table,5e) HANDLER(prefix,table,5f) \
+	HANDLER(prefix,table,60) HANDLER(prefix,table,61) HANDLER(prefix,table,62) HANDLER(prefix,table,63) \
+	HANDLER(prefix,table,64) HANDLER(prefix,table,65) HANDLER(prefix,table,66) HANDLER(prefix,table,67) \
+	HANDLER(prefix,table,68) HANDLER(prefix,table,69) HANDLER(prefix,table,6a) HANDLER(prefix,table,6b) \
+	HANDLER(prefix,table,6c) HANDLER(prefix,table,6d) HANDLER(prefix,table,6e) HANDLER(prefix,table,6f) \
+	HANDLER(prefix,table,70) HANDLER(prefix,table,71) HANDLER(prefix,table,72) HANDLER(prefix,table,73) \
+	HANDLER(prefix,table,74) HANDLER(prefix,table,75) HANDLER(prefix,table,76) HANDLER(prefix,table,77) \
+	HANDLER(prefix,table,78) HANDLER(prefix,table,79) HANDLER(prefix,table,7a) HANDLER(prefix,table,7b) \
+	HANDLER(prefix,table,7c) HANDLER(prefix,table,7d) HANDLER(prefix,table,7e) HANDLER(prefix,table,7f) \
+	HANDLER(prefix,table,80) HANDLER(prefix,table,81) HANDLER(prefix,table,82) HANDLER(prefix,table,83) \
+	HANDLER(prefix,table,84) HANDLER(prefix,table,85) HANDLER(prefix,table,86) HANDLER(prefix,table,87) \
+	HANDLER(prefix,table,88) HANDLER(prefix,table,89) HANDLER(prefix,table,8a) HANDLER(prefix,table,8b) \
+	HANDLER(prefix,table,8c) HANDLER(prefix,table,8d) HANDLER(prefix,table,8e) HANDLER(prefix,table,8f) \
+	HANDLER(prefix,table,90) HANDLER(prefix,table,91) HANDLER(prefix,table,92) HANDLER(prefix,table,93) \
+	HANDLER(prefix,table,94) HANDLER(prefix,table,95) HANDLER(prefix,table,96) HANDLER(prefix,table,97) \
+	HANDLER(prefix,table,98) HANDLER(prefix,table,99) HANDLER(prefix,table,9a) HANDLER(prefix,table,9b) \
+	HANDLER(prefix,table,9c) HANDLER(prefix,table,9d) HANDLER(prefix,table,9e) HANDLER(prefix,table,9f) \
+	HANDLER(prefix,table,a0) HANDLER(prefix,table,a1) HANDLER(prefix,table,a2) HANDLER(prefix,table,a3) \
+	HANDLER(prefix,table,a4) HANDLER(prefix,table,a5) HANDLER(prefix,table,a6) HANDLER(prefix,table,a7) \
+	HANDLER(prefix,table,a8) HANDLER(prefix,table,a9) HANDLER(prefix,table,aa) HANDLER(prefix,table,ab) \
+	HANDLER(prefix,table,ac) HANDLER(prefix,table,ad) HANDLER(prefix,table,ae) HANDLER(prefix,table,af) \
+	HANDLER(prefix,table,b0) HANDLER(prefix,table,b1) HANDLER(prefix,table,b2) HANDLER(prefix,table,b3) \
+	HANDLER(prefix,table,b4) HANDLER(prefix,table,b5) HANDLER(prefix,table,b6) HANDLER(prefix,table,b7) \
+	HANDLER(prefix,table,b8) HANDLER(prefix,table,b9) HANDLER(prefix,table,ba) HANDLER(prefix,table,bb) \
+	HANDLER(prefix,table,bc) HANDLER(prefix,table,bd) HANDLER(prefix,table,be) HANDLER(prefix,table,bf) \
+	HANDLER(prefix,table,c0) HANDLER(prefix,table,c1) HANDLER(prefix,table,c2) HANDLER(prefix,table,c3) \
+	HANDLER(prefix,table,c4) HANDLER(prefix,table,c5) HANDLER(prefix,table,c6) HANDLER(prefix,table,c7) \
+	HANDLER(prefix,table,c8) HANDLER(prefix,table,c9) HANDLER(prefix,table,ca) HANDLER(prefix,table,cb) \
+	HANDLER(prefix,table,cc) HANDLER(prefix,table,cd) HANDLER(prefix,table,ce) HANDLER(prefix,table,cf) \
+	HANDLER(prefix,table,d0) HANDLER(prefix,table,d1) HANDLER(prefix,table,d2) HANDLER(prefix,table,d3) \
+	HANDLER(prefix,table,d4) HANDLER(prefix,table,d5) HANDLER(prefix,table,d6) HANDLER(prefix,table,d7) \
+	HANDLER(prefix,table,d8) HANDLER(prefix,table,d9) HANDLER(prefix,table,da) HANDLER(prefix,table,db) \
+	HANDLER(prefix,table,dc) HANDLER(prefix,table,dd) HANDLER(prefix,table,de) HANDLER(prefix,table,df) \
+	HANDLER(prefix,table,e0) HANDLER(prefix,table,e1) HANDLER(prefix,table,e2) HANDLER(prefix,table,e3) \
+	HANDLER(prefix,table,e4) HANDLER(prefix,table,e5) HANDLER(prefix,table,e6) HANDLER(prefix,table,e7) \
+	HANDLER(prefix,table,e8) HANDLER(prefix,table,e9) HANDLER(prefix,table,ea) HANDLER(prefix,table,eb) \
+	HANDLER(prefix,table,ec) HANDLER(prefix,table,ed) HANDLER(prefix,table,ee) HANDLER(prefix,table,ef) \
+	HANDLER(prefix,table,f0) HANDLER(prefix,table,f1) HANDLER(prefix,table,f2) HANDLER(prefix,table,f3) \
+	HANDLER(prefix,table,f4) HANDLER(prefix,table,f5) HANDLER(prefix,table,f6) HANDLER(prefix,table,f7) \
+	HANDLER(prefix,table,f8) HANDLER(prefix,table,f9) HANDLER(prefix,table,fa) HANDLER(prefix,table,fb) \
+	HANDLER(prefix,table,fc) HANDLER(prefix,table,fd) HANDLER(prefix,table,fe) HANDLER(prefix,table,ff)
+#endif
+
 
 /***************************************************************
  * Enter HALT state; write 1 to fake port on first execution
@@ -560,7 +691,7 @@ STATIC_INLINE void BURNODD(int cycles, int opcodes, int cyclesum)
 #define ENTER_HALT {											\
 	PC--;														\
 	HALT = 1;													\
-	if( Z80.irq_state == CLEAR_LINE )							\
+	if( Z80.irq_state == CLEAR_LINE || !IFF1 )					\
 		z80_burn( z80_ICount );									\
 }
 
@@ -588,7 +719,7 @@ STATIC_INLINE void BURNODD(int cycles, int opcodes, int cyclesum)
 /***************************************************************
  * Read a byte from given memory location
  ***************************************************************/
-#define RM(addr) (Uint8)program_read_byte_8(addr)
+#define RM(addr) memory_base[(addr) & 0xffff]
 
 /***************************************************************
  * Read a word from given memory location
@@ -760,19 +891,102 @@ STATIC_INLINE Uint32 ARG16(void)
 	}															\
 }
 
+/***************************************************************
+ * Port poll loop: IN A,(n), a test of A, then a JR cc back to
+ * the IN that has just been taken. Unless the port says its
+ * value can change by itself, nothing the loop reads moves
+ * before this execution ends, so every pass goes the way the
+ * last one did. Whole passes are burned, leaving at least one
+ * cycle so the rest runs as it would have.
+ * The last pass has to have read the port in this execution:
+ * the host may have changed it in between two of them.
+ ***************************************************************/
+#if BUSY_LOOP_HACKS
+static int poll_in = -1;	/* address of the last IN A,(n) run */
+#define POLL_IN() poll_in = (PCD - 2) & 0xffff
+
+STATIC_INLINE void POLL_LOOP(unsigned jr, unsigned opcode)
+{
+	unsigned in = PCD;
+	unsigned test = (in + 2) & 0xffff;
+	Uint8 op = cpu_readop(test);
+	int length = 1, opcodes = 3, pass;
+
+	if( poll_in != (int)in || cpu_readop(in) != 0xdb )
+		return;
+	/* an interrupt would be taken before the IN */
+	if( Z80.irq_state != CLEAR_LINE && IFF1 )
+		return;
+
+	switch( op )
+	{
+		case 0xe6: case 0xee: case 0xf6: case 0xfe:	/* AND/XOR/OR/CP n */
+			length = 2;
+			/* fall through */
+		case 0x07: case 0x0f: case 0xa7: case 0xb7:	/* RLCA, RRCA, AND A, OR A */
+			pass = cc[Z80_TABLE_op][op];
+			break;
+		case 0xcb:									/* BIT b,A */
+			op = cpu_readop((test + 1) & 0xffff);
+			if( (op & 0xc7) != 0x47 )
+				return;
+			length = 2;
+			opcodes = 4;
+			pass = cc[Z80_TABLE_op][0xcb] + cc[Z80_TABLE_cb][op];
+			break;
+		default:
+			return;
+	}
+
+	if( ((test + length) & 0xffff) != jr )
+		return;
+	if( !io_read_steady(cpu_readop_arg((in + 1) & 0xffff) | (A << 8)) )
+		return;
+
+	pass += cc[Z80_TABLE_op][0xdb] + cc[Z80_TABLE_op][opcode] + cc[Z80_TABLE_ex][opcode];
+	if( z80_ICount > pass )
+	{
+		int n = (z80_ICount - 1) / pass;
+		R += n * opcodes;
+		z80_ICount -= n * pass;
+		z80_idle_cycles += n * pass;
+	}
+}
+#else
+#define POLL_IN()
+#endif
+
 /***************************************************************
  * JR_COND
  ***************************************************************/
+#if BUSY_LOOP_HACKS
 #define JR_COND(cond,opcode)									\
 	if( cond )													\
 	{															\
+		unsigned oldpc = PCD-1;									\
 		Sint8 arg = (Sint8)ARG(); /* ARG() also increments PC */	\
 		PC += arg;				/* so don't do PC += ARG() */	\
 		CC(ex,opcode);											\
 		change_pc(PCD);											\
+		/* speed up port poll loop */							\
+		if( arg < 0 )											\
+			POLL_LOOP(oldpc, opcode);							\
 	}															\
 	else PC++;													\
 
+#else
+#define JR_COND(cond,opcode)									\
+	if( cond )													\
+	{															\
+		Sint8 arg = (Sint8)ARG(); /* ARG() also increments PC */	\
+		PC += arg;				/* so don't do PC += ARG() */	\
+		CC(ex,opcode);											\
+		change_pc(PCD);											\
+	}															\
+	else PC++;													\
+
+#endif
+
 /***************************************************************
  * CALL
  ***************************************************************/
@@ -3270,7 +3484,7 @@ OP(op,d7) { RST(0x10);											} /* RST  2           */
 OP(op,d8) { RET_COND( F & CF, 0xd8 );							} /* RET  C           */
 OP(op,d9) { EXX;												} /* EXX              */
 OP(op,da) { JP_COND( F & CF );									} /* JP   C,a         */
-OP(op,db) { unsigned n = ARG() | (A << 8); A = IN( n );			} /* IN   A,(n)       */
+OP(op,db) { unsigned n = ARG() | (A << 8); A = IN( n ); POLL_IN();	} /* IN   A,(n)       */
 OP(op,dc) { CALL_COND( F & CF, 0xdc );							} /* CALL C,a         */
 OP(op,dd) { R++; EXEC(dd,ROP());								} /* **** DD xx       */
 OP(op,de) { SBC(ARG());											} /* SBC  A,n         */
@@ -3319,6 +3533,9 @@ static void take_interrupt(void)
 
 	/* there isn't a valid previous program counter */
 	PRVPC = -1;
+#if BUSY_LOOP_HACKS
+	poll_in = -1;
+#endif
 
 	/* Check if processor was halted */
 	LEAVE_HALT;
@@ -3522,12 +3739,47 @@ void z80_exit(void)
 #endif
 }
 
+/****************************************************************************
+ * Set the 64KiB of RAM opcodes and memory reads come from
+ ****************************************************************************/
+void z80_set_memory(Uint8 *ram)
+{
+	memory_base = ram;
+}
+
 /****************************************************************************
  * Execute 'cycles' T-states. Return number of T-states really executed
  ****************************************************************************/
+#if Z80_COMPUTED_GOTO
+/* the prefixes jump on to the next byte's label in z80_execute, which */
+/* takes its T-states, where EXEC would take them and call through a table */
+#define op_cb()		{ R++; goto *cb_labels[ROP()]; }
+#define op_dd()		{ R++; goto *dd_labels[ROP()]; }
+#define op_ed()		{ R++; goto *ed_labels[ROP()]; }
+#define op_fd()		{ R++; goto *fd_labels[ROP()]; }
+#define dd_cb()		{ EAX; goto *xycb_labels[ARG()]; }
+#define fd_cb()		{ EAY; goto *xycb_labels[ARG()]; }
+#define dd_dd()		{ illegal_1(); op_dd(); }
+#define dd_fd()		{ illegal_1(); op_fd(); }
+#define fd_dd()		{ illegal_1(); op_dd(); }
+#define fd_fd()		{ illegal_1(); op_fd(); }
+#endif
+
 int z80_execute(int cycles)
 {
+#if Z80_COMPUTED_GOTO
+	static const void *const op_labels[0x100] = LABELS(op);
+	static const void *const cb_labels[0x100] = LABELS(cb);
+	static const void *const dd_labels[0x100] = LABELS(dd);
+	static const void *const ed_labels[0x100] = LABELS(ed);
+	static const void *const fd_labels[0x100] = LABELS(fd);
+	static const void *const xycb_labels[0x100] = LABELS(xycb);
+#endif
+
 	z80_ICount = cycles;
+#if BUSY_LOOP_HACKS
+	poll_in = -1;
+#endif
 
 	/* check for NMIs on the way in; they can only be set externally */
 	/* via timers, and can't be dynamically enabled, so it is safe */
@@ -3556,7 +3808,19 @@ int z80_execute(int cycles)
 		PRVPC = PCD;
 		CALL_DEBUGGER(PCD);
 		R++;
+#if Z80_COMPUTED_GOTO
+		goto *op_labels[ROP()];
+
+		HANDLERS(op,op)
+		HANDLERS(cb,cb)
+		HANDLERS(dd,xy)
+		HANDLERS(ed,ed)
+		HANDLERS(fd,xy)
+		HANDLERS(xycb,xycb)
+next:	;
+#else
 		EXEC_STATIC_INLINE(op,ROP());
+#endif
 	} while( z80_ICount > 0 );
 
 	return cycles - z80_ICount;
@@ -3573,6 +3837,7 @@ static void z80_burn(int cycles)
 		int n = (cycles + 3) / 4;
 		R += n;
 		z80_ICount -= 4 * n;
+		z80_idle_cycles += 4 * n;
 	}
 }
 
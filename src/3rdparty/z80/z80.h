@@ -56,11 +56,15 @@ typedef struct
 
 extern int z80_ICount;
 
+/* T-states HALT and the busy and poll loop shortcuts skipped; the host clears it */
+extern int z80_idle_cycles;
+
 extern Z80_Regs Z80;
 
 void z80_init ( int index, int clock, const void *config, int ( *irqcallback ) ( int ) );
 void z80_reset ( void );
 void z80_exit ( void );
+void z80_set_memory ( Uint8 *ram );
 int  z80_execute ( int cycles );
 void z80_set_irq_line ( int irqline, int state );
 
@@ -11,7 +11,9 @@
 
 void YM2610UpdateRequest(void)
 {
-    const int32_t currentSample = neocd->audio.buffer.masterCyclesThisFrameToSample(neocd->z80CyclesThisFrame());
+    // The Z80's last instruction of a frame can take it a little past the end
+    const int32_t currentSample = std::min(neocd->audio.buffer.masterCyclesThisFrameToSample(neocd->z80CyclesThisFrame()),
+                                           int32_t(neocd->audio.buffer.sampleCount));
 
     if (currentSample > int32_t(neocd->audio.buffer.writePointer))
         YM2610Update(currentSample - neocd->audio.buffer.writePointer);
@@ -0,0 +1,100 @@
+#include <cstdlib>
+
+#include "3rdparty/musashi/m68k.h"
+#include "diagnostics.h"
+#include "libretro_log.h"
+#include "memory.h"
+
+bool Diagnostics::watching = false;
+
+namespace
+{
+    struct Watchpoint
+    {
+        uint32_t address;
+        uint32_t hits;
+    };
+
+    Watchpoint watchpoints[Diagnostics::MAX_WATCHPOINTS];
+    uint32_t watchpointCount = 0;
+
+    uint32_t biosEntries[Diagnostics::MAX_BIOS_ENTRIES];
+    uint32_t biosEntryCount = 0;
+}
+
+void Diagnostics::init()
+{
+    watchpointCount = 0;
+    biosEntryCount = 0;
+
+    const char* list = std::getenv("NEOCD_WATCH");
+
+    while (list && *list && (watchpointCount < MAX_WATCHPOINTS))
+    {
+        char* end;
+        const uint32_t address = static_cast<uint32_t>(std::strtoul(list, &end, 16)) & 0xFFFFFF;
+
+        if (end == list)
+            break;
+
+        watchpoints[watchpointCount++] = { address, 0 };
+        Libretro::Log::message(RETRO_LOG_INFO, "Watching writes to %06X\n", address);
+
+        list = (*end == ',') ? end + 1 : end;
+    }
+
+    watching = (watchpointCount != 0);
+}
+
+bool Diagnostics::watchesPage(uint32_t page)
+{
+    for (uint32_t i = 0; i < watchpointCount; ++i)
+    {
+        if (watchpoints[i].address / Memory::MEMORY_GRANULARITY == page)
+            return true;
+    }
+
+    return false;
+}
+
+void Diagnostics::watchWrite(uint32_t address, uint32_t size, uint32_t data)
+{
+    address &= 0xFFFFFF;
+
+    for (uint32_t i = 0; i < watchpointCount; ++i)
+    {
+        Watchpoint& watchpoint = watchpoints[i];
+
+        if ((watchpoint.address - address) >= size)
+            continue;
+
+        if (watchpoint.hits >= MAX_WATCH_HITS)
+            continue;
+
+        ++watchpoint.hits;
+
+        // Just the byte at the watched address, out of a big endian word or long word
+        const uint32_t shift = (size - 1 - (watchpoint.address - address)) * 8;
+
+        Libretro::Log::message(RETRO_LOG_INFO, "%06X = %02X from %06X\n",
+            watchpoint.address, (data >> shift) & 0xFF, m68k_get_reg(nullptr, M68K_REG_PPC));
+    }
+}
+
+void Diagnostics::biosEntry(uint32_t pc)
+{
+    if (!Libretro::Log::enabled(RETRO_LOG_DEBUG))
+        return;
+
+    for (uint32_t i = 0; i < biosEntryCount; ++i)
+    {
+        if (biosEntries[i] == pc)
+            return;
+    }
+
+    if (biosEntryCount >= MAX_BIOS_ENTRIES)
+        return;
+
+    biosEntries[biosEntryCount++] = pc;
+    Libretro::Log::message(RETRO_LOG_DEBUG, "BIOS entry %06X\n", pc);
+}
@@ -0,0 +1,51 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <cstdint>
+
+/*
+    Debugging aids that cost nothing until they are asked for.
+
+    Write watchpoints come from the NEOCD_WATCH environment variable, read once
+    at startup: a comma separated list of hexadecimal addresses, for example
+    NEOCD_WATCH=10FD8F,10FE00. A page holding a watched address is never handed
+    to the CPU as a direct page, so every write to it reaches m68kintf.cpp, where
+    a single flag says whether there is anything to check.
+
+    BIOS entry points are logged at the debug level, once each, and only when
+    the log level lets debug messages through.
+*/
+namespace Diagnostics
+{
+    /// Read the watchpoints from the environment, before the memory map is built
+    void init();
+
+    /// True if some address in the page of the 68000 address space is watched
+    bool watchesPage(uint32_t page);
+
+    /// Log the write if it touches a watched address
+    void watchWrite(uint32_t address, uint32_t size, uint32_t data);
+
+    /// Log a BIOS entry point the first time it is called
+    void biosEntry(uint32_t pc);
+
+    /// True once at least one watchpoint is set
+    extern bool watching;
+
+    inline void checkWrite(uint32_t address, uint32_t size, uint32_t data)
+    {
+        if (watching)
+            watchWrite(address, size, data);
+    }
+
+    /// Most addresses that can be watched at once
+    static constexpr uint32_t MAX_WATCHPOINTS = 8;
+
+    /// Hits logged per watchpoint before it goes quiet
+    static constexpr uint32_t MAX_WATCH_HITS = 6;
+
+    /// Distinct BIOS entry points logged
+    static constexpr uint32_t MAX_BIOS_ENTRIES = 64;
+} // namespace Diagnostics
+
+#endif // DIAGNOSTICS_H
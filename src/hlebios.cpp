@@ -7,6 +7,7 @@
 #include "3rdparty/ym/ym2610.h"
 #include "3rdparty/z80/z80.h"
 #include "datapacker.h"
+#include "diagnostics.h"
 #include "hlebios.h"
 #include "libretro_common.h"
 #include "libretro_log.h"
@@ -583,6 +584,20 @@ bool HleBios::loadIplEntry(const IplEntry& entry)
     if (first < data.size())
         std::memcpy(destination, data.data() + first, data.size() - first);
 
+    // Straight into program RAM, where the 68000 may have cached the
+    // code a previous file put there.
+    if (destination == neocd->memory.ram)
+    {
+        m68k_invalidate_code(offset, static_cast<uint32_t>(first));
+        if (first < data.size())
+            m68k_invalidate_code(0, static_cast<uint32_t>(data.size() - first));
+    }
+
+    // Straight into sprite RAM, past the write handlers that would
+    // otherwise have told the decoded tiles about it.
+    if (destination == neocd->memory.sprRam)
+        neocd->video.invalidateSpriteTiles(offset, static_cast<uint32_t>(data.size()));
+
     // The data is here at once, which is worth keeping - nobody wants a
     // loading screen back. What is not free is the time a drive would
     // have spent getting it: at 75 sectors a second, this file would
@@ -627,7 +642,10 @@ bool HleBios::loadIplEntry(const IplEntry& entry)
        nothing where the map still said empty.
     */
     if (ext == "FIX")
+    {
         neocd->video.updateFixUsageMap();
+        neocd->video.invalidateFixLayer();
+    }
 
     return true;
 }
@@ -972,6 +990,7 @@ void HleBios::initBiosRam()
     neocd->video.videoEnable = true;
     neocd->video.sprDisable = false;
     neocd->video.fixDisable = false;
+    neocd->video.pictureChanged();
 
     // The interrupt masks are hardware registers the real BIOS writes
     // while starting up, not something a game sets for itself. Without
@@ -1304,17 +1323,10 @@ void HleBios::callUser(uint8_t request)
 
 int HleBios::trap(uint32_t pc)
 {
-    if (getenv("ENTLOG"))
-    {
-        static unsigned seen[64]; static unsigned nseen = 0;
-        bool has = false;
-        for (unsigned q = 0; q < nseen; ++q) if (seen[q] == pc) { has = true; break; }
-        if (!has && nseen < 64)
-        {
-            seen[nseen++] = pc;
-            fprintf(stderr, "entry %06X\n", pc);
-        }
-    }
+    Diagnostics::biosEntry(pc);
+
+    // Calls read and write the Z80's memory and move its reset line, so it has to be up to date
+    neocd->syncZ80();
 
     switch (pc)
     {
@@ -1594,6 +1606,7 @@ int HleBios::trap(uint32_t pc)
                         neocd->memory.fixRam[at & 0x1FFFF] = value;
                         if (value)
                             neocd->video.fixUsageMap[(at & 0x1FFFF) >> 5] = 1;
+                        neocd->video.fixCharacterChanged((at & 0x1FFFF) >> 5);
                         break;
                     case 3:
                         if (at < Memory::Z80RAM_SIZE)
@@ -1664,6 +1677,9 @@ int HleBios::trap(uint32_t pc)
         {
             uint16_t* vram = neocd->memory.videoRam;
 
+            // Straight into video RAM, so the video has to be told.
+            neocd->video.pictureMemoryWrite();
+
             for (uint32_t i = 0; i < 0x200; ++i)
             {
                 vram[0x8000 + i] = 0x0FFF;
@@ -1671,6 +1687,8 @@ int HleBios::trap(uint32_t pc)
                 vram[0x8400 + i] = 0xB000;
             }
 
+            neocd->video.spriteIndexDirty = true;
+
             // Left as the routine leaves them: the step it set, and the
             // address just past the last block it wrote.
             neocd->video.videoramModulo = 1;
@@ -1723,6 +1741,9 @@ int HleBios::trap(uint32_t pc)
             uint16_t* vram = neocd->memory.videoRam;
             uint32_t at = 0x701E;
 
+            // The last of it lands in the sprite tile maps
+            neocd->video.pictureMemoryWrite();
+
             for (uint32_t i = 0; i < 0x4C0; ++i)
                 vram[(at + i) & 0xFFFF] = 0x00FF;
 
@@ -1736,6 +1757,7 @@ int HleBios::trap(uint32_t pc)
 
             neocd->video.videoramModulo = 1;
             neocd->video.videoramOffset = (0x6FFE + 0x20) & 0xFFFF;
+            neocd->video.invalidateFixLayer();
         }
         return 1;
 
@@ -0,0 +1,167 @@
+#include "3rdparty/musashi/m68k.h"
+#include "idleloop.h"
+#include "memory.h"
+
+namespace
+{
+    // Page of plain memory holding address, or nullptr
+    const uint8_t* directPage(const Memory& memory, uint32_t address)
+    {
+        const Memory::Region* region = memory.regionLookupTable[(address & 0xFFFFFF) / Memory::MEMORY_GRANULARITY];
+
+        if (!region || !(region->flags & Memory::Region::ReadDirect))
+            return nullptr;
+
+        return &region->readBase[(address & ~(Memory::MEMORY_GRANULARITY - 1)) & region->addressMask];
+    }
+
+    bool readWord(const Memory& memory, uint32_t address, uint32_t& value)
+    {
+        const uint8_t* page = directPage(memory, address);
+
+        if (!page || (address & 1))
+            return false;
+
+        page += address & (Memory::MEMORY_GRANULARITY - 1);
+        value = (page[0] << 8) | page[1];
+        return true;
+    }
+
+    /*
+        Decodes an operand in memory that the loop reads: (An), d16(An), (xxx).W or (xxx).L.
+        Extension words are read at pc, which is moved past them. The operand has to be
+        in plain memory, and aligned if it is more than a byte.
+    */
+    bool readOperand(const Memory& memory, uint32_t ea, uint32_t size, uint32_t& pc)
+    {
+        const uint32_t mode = (ea >> 3) & 7;
+        const uint32_t reg = ea & 7;
+        uint32_t address;
+        uint32_t extension;
+
+        if (mode == 2)
+            address = m68k_get_reg(nullptr, static_cast<m68k_register_t>(M68K_REG_A0 + reg));
+        else if (mode == 5)
+        {
+            if (!readWord(memory, pc, extension))
+                return false;
+
+            address = m68k_get_reg(nullptr, static_cast<m68k_register_t>(M68K_REG_A0 + reg)) + static_cast<int16_t>(extension);
+            pc += 2;
+        }
+        else if ((mode == 7) && (reg == 0))
+        {
+            if (!readWord(memory, pc, extension))
+                return false;
+
+            address = static_cast<int16_t>(extension);
+            pc += 2;
+        }
+        else if ((mode == 7) && (reg == 1))
+        {
+            uint32_t low;
+
+            if (!readWord(memory, pc, extension) || !readWord(memory, pc + 2, low))
+                return false;
+
+            address = (extension << 16) | low;
+            pc += 4;
+        }
+        else
+            return false;
+
+        if ((size > 1) && (address & 1))
+            return false;
+
+        return directPage(memory, address) && directPage(memory, address + size - 1);
+    }
+
+    // Bytes in an operand of the usual two bit size field, or zero
+    uint32_t operandSize(uint32_t field)
+    {
+        static const uint32_t SIZES[4] = { 1, 2, 4, 0 };
+        return SIZES[field & 3];
+    }
+}
+
+bool IdleLoop::recognise(const Memory& memory, uint32_t pc)
+{
+    uint32_t opcode;
+    uint32_t next = pc + 2;
+
+    if (!readWord(memory, pc, opcode))
+        return false;
+
+    if ((opcode & 0xFF00) == 0x4A00)
+    {
+        // TST <ea>
+        const uint32_t size = operandSize(opcode >> 6);
+
+        if (!size || !readOperand(memory, opcode, size, next))
+            return false;
+    }
+    else if ((opcode & 0xFFC0) == 0x0800)
+    {
+        // BTST #n,<ea>
+        next += 2;
+
+        if (!readOperand(memory, opcode, 1, next))
+            return false;
+    }
+    else if ((opcode & 0xFF00) == 0x0C00)
+    {
+        // CMPI #n,<ea>
+        const uint32_t size = operandSize(opcode >> 6);
+
+        if (!size)
+            return false;
+
+        next += (size == 4) ? 4 : 2;
+
+        if (!readOperand(memory, opcode, size, next))
+            return false;
+    }
+    else if ((opcode & 0xF100) == 0xB000)
+    {
+        // CMP <ea>,Dn
+        const uint32_t size = operandSize(opcode >> 6);
+
+        if (!size || !readOperand(memory, opcode, size, next))
+            return false;
+    }
+    else if (((opcode & 0xC1C0) == 0x0000) && (opcode & 0x3000))
+    {
+        // MOVE <ea>,Dn, which loads the same value every time round
+        static const uint32_t MOVE_SIZES[4] = { 0, 1, 4, 2 };
+
+        if (!readOperand(memory, opcode, MOVE_SIZES[(opcode >> 12) & 3], next))
+            return false;
+    }
+    else
+        return false;
+
+    // Bcc back to the first instruction; BRA and BSR are not conditional
+    uint32_t branch;
+
+    if (!readWord(memory, next, branch))
+        return false;
+
+    if (((branch & 0xF000) != 0x6000) || (((branch >> 8) & 0xF) < 2))
+        return false;
+
+    int32_t displacement = static_cast<int8_t>(branch & 0xFF);
+
+    if (displacement == 0)
+    {
+        uint32_t extension;
+
+        if (!readWord(memory, next + 2, extension))
+            return false;
+
+        displacement = static_cast<int16_t>(extension);
+    }
+    else if (displacement == -1)
+        return false;
+
+    return ((next + 2 + displacement) & 0xFFFFFF) == (pc & 0xFFFFFF);
+}
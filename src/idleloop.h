@@ -0,0 +1,28 @@
+#ifndef IDLELOOP_H
+#define IDLELOOP_H
+
+#include <cstdint>
+
+class Memory;
+
+/*
+    Recognises the loops games spin in while they wait for an interrupt:
+    one instruction that tests, compares or loads an operand in plain RAM or
+    ROM, then a conditional branch back to it. For example:
+
+        wait:   tst.b   $10FD80
+                beq.s   wait
+
+    Within a timeslice nothing but the 68000 itself can change RAM, and an
+    interrupt only arrives when the slice ends, so a loop like this goes round
+    with the same registers and the same memory until then. Only the form is
+    checked here; whether the branch is actually taken is left to the caller,
+    which goes round once for real before skipping anything.
+*/
+namespace IdleLoop
+{
+    /// True if the code at pc is a loop of the form above
+    bool recognise(const Memory& memory, uint32_t pc);
+} // namespace IdleLoop
+
+#endif // IDLELOOP_H
@@ -2,8 +2,10 @@
 #include <file/file_path.h>
 #include <retro_dirent.h>
 
+#include "3rdparty/musashi/m68k.h"
 #include "libretro_backupram.h"
 #include "libretro_bios.h"
+#include "diagnostics.h"
 #include "hlebios.h"
 #include "libretro_common.h"
 #include "libretro_input.h"
@@ -175,13 +177,6 @@ bool retro_load_game(const struct retro_game_info *info)
     // Initialize inputs
     Libretro::Input::init();
 
-    enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_RGB565;
-    if (!libretro.environment(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt))
-    {
-        Libretro::Log::message(RETRO_LOG_ERROR, "RGB565 support is required!\n");
-        return false;
-    }
-
     // Load the BIOS
     if (!Libretro::Bios::load())
         return false;
@@ -193,6 +188,28 @@ bool retro_load_game(const struct retro_game_info *info)
     // Update variables and reset
     Libretro::Variables::update(true);
 
+    // The color depth option only takes effect here, the pixel format being fixed once the game is loaded
+    enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_XRGB8888;
+    if (globals.colorDepth24 && libretro.environment(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt))
+        neocd->video.pixelFormat = VideoBlit::PIXEL_FORMAT_XRGB8888;
+    else
+    {
+        fmt = RETRO_PIXEL_FORMAT_RGB565;
+        if (!libretro.environment(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt))
+        {
+            Libretro::Log::message(RETRO_LOG_ERROR, "RGB565 support is required!\n");
+            return false;
+        }
+
+        neocd->video.pixelFormat = VideoBlit::PIXEL_FORMAT_RGB565;
+    }
+
+    neocd->video.redrawPicture();
+
+    // Whether a frame that did not change can be left out of retro_run's call to the frontend
+    globals.canDupe = false;
+    libretro.environment(RETRO_ENVIRONMENT_GET_CAN_DUPE, &globals.canDupe);
+
     // Set libretro memory maps
     Libretro::Memmap::init();
 
@@ -221,6 +238,17 @@ bool retro_load_game_special(unsigned game_type, const struct retro_game_info *i
 void retro_unload_game(void)
 {
     Libretro::BackupRam::save();
+
+    const Video::SpriteIndexStats& stats = neocd->video.spriteIndexStats;
+    Libretro::Log::message(RETRO_LOG_DEBUG,
+        "Video: sprite index rebuilt %llu times, updated %llu times instead, %llu lines relisted, %llu lines left alone.\n",
+        static_cast<unsigned long long>(stats.rebuilds),
+        static_cast<unsigned long long>(stats.updates),
+        static_cast<unsigned long long>(stats.linesRelisted),
+        static_cast<unsigned long long>(stats.linesAvoided));
+
+    // No render threads left running with nothing to render
+    neocd->video.workers.resize(0);
 }
 
 unsigned retro_get_region(void)
@@ -268,6 +296,12 @@ void retro_run(void)
     if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE_UPDATE, &updated) && updated)
         Libretro::Variables::update(false);
 
+    // Cheats and achievements write to the 68000's RAM through retro_get_memory_data
+    // and the memory map, behind the block cache's back, so nothing it recorded
+    // from the last frame can be trusted
+    if (globals.m68kBlockCache)
+        m68k_invalidate_code(0, 0x1000000);
+
     // Update inputs
     Libretro::Input::update();
 
@@ -291,10 +325,14 @@ void retro_run(void)
 
     // Send audio and video to the frontend
     libretro.audioBatch(reinterpret_cast<const int16_t*>(&neocd->audio.buffer.ymSamples[0]), neocd->audio.buffer.sampleCount);
-    libretro.video(neocd->video.frameBuffer + globals.overscanH,
+    // A picture no line of which was drawn again since the last one went out is sent as a duplicate
+    const uint32_t bytesPerPixel = neocd->video.bytesPerPixel();
+    const bool duplicate = !neocd->video.frameChanged && globals.canDupe;
+    libretro.video(duplicate ? nullptr : static_cast<const uint8_t*>(neocd->video.frameBuffer) + (globals.overscanH * bytesPerPixel),
                    Video::FRAMEBUFFER_WIDTH - (globals.overscanH * 2),
                    Video::FRAMEBUFFER_HEIGHT,
-                   Video::FRAMEBUFFER_WIDTH * sizeof(uint16_t));
+                   Video::FRAMEBUFFER_WIDTH * bytesPerPixel);
+    neocd->video.frameChanged = false;
 }
 
 void retro_init(void)
@@ -302,6 +340,9 @@ void retro_init(void)
     // Initialize the logging interface
     Libretro::Log::init();
 
+    // Read the watchpoints, before the memory map that leaves their pages out is built
+    Diagnostics::init();
+
     // Initialize VFS (If the call fails, fallback versions are used)
     initVfs();
 
@@ -62,7 +62,28 @@ struct Globals
     // 68000 overclock, in percent of the stock clock. 100 is stock.
     uint32_t cpuOverclock{ 100 };
 
+    // Skip whole passes of the loops the 68000 waits for interrupts in
+    bool idleLoopSkip{ true };
+
+    // Replay the 68000's decoded instructions instead of fetching and decoding them again
+    bool m68kBlockCache{ true };
+
     bool perContentSaves{ false };
+
+    // Draw each line's sprites nearest first, skipping the pixels they hide
+    bool spriteFrontToBack{ true };
+
+    // Present 24 bit color rather than 16; read when a game is loaded
+    bool colorDepth24{ false };
+
+    // Can the frontend show the last frame again when handed none?
+    bool canDupe{ false };
+
+    // Threads lines are rendered on, zero to render them inline
+    uint32_t renderThreads{ 0 };
+
+    // Run the Z80 and the YM2610 on a thread of their own
+    bool soundThread{ true };
 };
 
 extern LibretroCallbacks libretro;
@@ -20,6 +20,8 @@ constexpr int ERROR_DURATION_FRAMES = ERROR_DURATION_SECS * 60.0;
 
 constexpr int PRINTF_BUFFER_SIZE = 512;
 
+retro_log_level Libretro::Log::minimumLevel = RETRO_LOG_DEBUG;
+
 void Libretro::Log::init()
 {
     // Query the message interface version
@@ -33,7 +35,7 @@ void Libretro::Log::init()
         libretro.log = nullptr;
 }
 
-void Libretro::Log::message(retro_log_level level, const char* format, ...)
+void Libretro::Log::write(retro_log_level level, const char* format, ...)
 {
     char buffer[PRINTF_BUFFER_SIZE];
 
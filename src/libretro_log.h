@@ -3,13 +3,36 @@
 
 #include "libretro.h"
 
+/*
+    Messages below this level are compiled out. Everything is built in by default,
+    which leaves it to the Log Level core option to decide what is formatted.
+*/
+#if !defined(NEOCD_LOG_FLOOR)
+#define NEOCD_LOG_FLOOR RETRO_LOG_DEBUG
+#endif
+
 namespace Libretro
 {
     namespace Log
     {
         void init();
 
-        void message(retro_log_level level, const char* format, ...);
+        /// Messages below this level are dropped before anything is formatted
+        extern retro_log_level minimumLevel;
+
+        inline bool enabled(retro_log_level level)
+        {
+            return (level >= NEOCD_LOG_FLOOR) && (level >= minimumLevel);
+        }
+
+        void write(retro_log_level level, const char* format, ...);
+
+        template<typename... Args>
+        inline void message(retro_log_level level, const char* format, Args... args)
+        {
+            if (enabled(level))
+                write(level, format, args...);
+        }
     } // namespace Log
 } // namespace Libretro
 
@@ -1,8 +1,10 @@
 #include <cstdlib>
 #include <vector>
 
+#include "3rdparty/musashi/m68k.h"
 #include "libretro_bios.h"
 #include "libretro_common.h"
+#include "libretro_log.h"
 #include "libretro_variables.h"
 #include "libretro.h"
 #include "neogeocd.h"
@@ -16,6 +18,13 @@ static const char* const LOADSKIP_VARIABLE = "neocd_loadskip";
 static const char* const PER_CONTENT_SAVES_VARIABLE = "neocd_per_content_saves";
 static const char* const OVERSCAN_H_VARIABLE = "neocd_overscan_h";
 static const char* const CPU_OVERCLOCK_VARIABLE = "neocd_cpu_overclock";
+static const char* const SPRITE_ORDER_VARIABLE = "neocd_sprite_order";
+static const char* const COLOR_DEPTH_VARIABLE = "neocd_color_depth";
+static const char* const RENDER_THREADS_VARIABLE = "neocd_render_threads";
+static const char* const SOUND_THREAD_VARIABLE = "neocd_sound_thread";
+static const char* const LOG_LEVEL_VARIABLE = "neocd_log_level";
+static const char* const IDLE_SKIP_VARIABLE = "neocd_idle_skip";
+static const char* const BLOCK_CACHE_VARIABLE = "neocd_block_cache";
 
 static const char* const CATEGORY_SYSTEM = "system";
 static const char* const CATEGORY_VIDEO = "video";
@@ -120,10 +129,17 @@ static void buildLegacyVariables()
         variables.emplace_back(retro_variable{ BIOS_VARIABLE, globals.biosChoices.c_str() });
 
     variables.emplace_back(retro_variable{ OVERSCAN_H_VARIABLE, "Horizontal Overscan Mask; 8|4|0|12|16" });
+    variables.emplace_back(retro_variable{ SPRITE_ORDER_VARIABLE, "Sprite Drawing Order; Front to back|Back to front" });
+    variables.emplace_back(retro_variable{ COLOR_DEPTH_VARIABLE, "Color Depth (Restart); 16-bit|24-bit" });
     variables.emplace_back(retro_variable{ SPEEDHACK_VARIABLE, "CD Speed Hack; On|Off" });
     variables.emplace_back(retro_variable{ CPU_OVERCLOCK_VARIABLE, "CPU Overclock; 100%|110%|125%|150%|200%" });
+    variables.emplace_back(retro_variable{ RENDER_THREADS_VARIABLE, "Render Threads; Off|Auto|1|2|3|4" });
+    variables.emplace_back(retro_variable{ SOUND_THREAD_VARIABLE, "Sound Thread; On|Off" });
+    variables.emplace_back(retro_variable{ IDLE_SKIP_VARIABLE, "Idle Loop Skip; On|Off" });
+    variables.emplace_back(retro_variable{ BLOCK_CACHE_VARIABLE, "68000 Block Cache; On|Off" });
     variables.emplace_back(retro_variable{ LOADSKIP_VARIABLE, "Skip CD Loading; On|Off" });
     variables.emplace_back(retro_variable{ PER_CONTENT_SAVES_VARIABLE, "Per-Game Saves (Restart); Off|On" });
+    variables.emplace_back(retro_variable{ LOG_LEVEL_VARIABLE, "Log Level; Debug|Info|Warning|Error" });
 
     variables.emplace_back(retro_variable{ nullptr, nullptr });
 }
@@ -131,7 +147,7 @@ static void buildLegacyVariables()
 static void buildCoreOptionsV2()
 {
     coreOptionDefinitions.clear();
-    coreOptionDefinitions.reserve(7);
+    coreOptionDefinitions.reserve(13);
 
     retro_core_option_v2_definition option;
 
@@ -149,6 +165,14 @@ static void buildCoreOptionsV2()
     fillBasicOption(option, OVERSCAN_H_VARIABLE, "Horizontal Overscan Mask", CATEGORY_VIDEO, "8", overscanValues, 5);
     coreOptionDefinitions.emplace_back(option);
 
+    const char* const spriteOrderValues[] = { "Front to back", "Back to front" };
+    fillBasicOption(option, SPRITE_ORDER_VARIABLE, "Sprite Drawing Order", CATEGORY_VIDEO, "Front to back", spriteOrderValues, 2);
+    coreOptionDefinitions.emplace_back(option);
+
+    const char* const colorDepthValues[] = { "16-bit", "24-bit" };
+    fillBasicOption(option, COLOR_DEPTH_VARIABLE, "Color Depth (Restart)", CATEGORY_VIDEO, "16-bit", colorDepthValues, 2);
+    coreOptionDefinitions.emplace_back(option);
+
     const char* const onOffValues[] = { "On", "Off" };
     fillBasicOption(option, SPEEDHACK_VARIABLE, "CD Speed Hack", CATEGORY_ADVANCED, "On", onOffValues, 2);
     coreOptionDefinitions.emplace_back(option);
@@ -160,10 +184,27 @@ static void buildCoreOptionsV2()
     fillBasicOption(option, CPU_OVERCLOCK_VARIABLE, "CPU Overclock", CATEGORY_ADVANCED, "100%", overclockValues, 5);
     coreOptionDefinitions.emplace_back(option);
 
+    const char* const renderThreadsValues[] = { "Off", "Auto", "1", "2", "3", "4" };
+    fillBasicOption(option, RENDER_THREADS_VARIABLE, "Render Threads", CATEGORY_ADVANCED, "Off", renderThreadsValues, 6);
+    coreOptionDefinitions.emplace_back(option);
+
+    fillBasicOption(option, SOUND_THREAD_VARIABLE, "Sound Thread", CATEGORY_ADVANCED, "On", onOffValues, 2);
+    coreOptionDefinitions.emplace_back(option);
+
+    fillBasicOption(option, IDLE_SKIP_VARIABLE, "Idle Loop Skip", CATEGORY_ADVANCED, "On", onOffValues, 2);
+    coreOptionDefinitions.emplace_back(option);
+
+    fillBasicOption(option, BLOCK_CACHE_VARIABLE, "68000 Block Cache", CATEGORY_ADVANCED, "On", onOffValues, 2);
+    coreOptionDefinitions.emplace_back(option);
+
     const char* const offOnValues[] = { "Off", "On" };
     fillBasicOption(option, PER_CONTENT_SAVES_VARIABLE, "Per-Game Saves (Restart)", CATEGORY_SYSTEM, "Off", offOnValues, 2);
     coreOptionDefinitions.emplace_back(option);
 
+    const char* const logLevelValues[] = { "Debug", "Info", "Warning", "Error" };
+    fillBasicOption(option, LOG_LEVEL_VARIABLE, "Log Level", CATEGORY_ADVANCED, "Debug", logLevelValues, 4);
+    coreOptionDefinitions.emplace_back(option);
+
     coreOptionDefinitions.emplace_back(retro_core_option_v2_definition{});
     coreOptionsV2.definitions = coreOptionDefinitions.data();
 }
@@ -246,9 +287,24 @@ void Libretro::Variables::update(bool needReset)
             geometry.aspect_ratio = Video::ASPECT_RATIO;
 
             libretro.environment(RETRO_ENVIRONMENT_SET_GEOMETRY, &geometry);
+
+            // The next frame has to go out whole, even if nothing in it moved
+            neocd->video.redrawPicture();
         }
     }
 
+    var.value = NULL;
+    var.key = SPRITE_ORDER_VARIABLE;
+
+    if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+        globals.spriteFrontToBack = strcmp(var.value, "Back to front") ? true : false;
+
+    var.value = NULL;
+    var.key = COLOR_DEPTH_VARIABLE;
+
+    if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+        globals.colorDepth24 = strcmp(var.value, "24-bit") ? false : true;
+
     var.value = NULL;
     var.key = SPEEDHACK_VARIABLE;
 
@@ -279,12 +335,73 @@ void Libretro::Variables::update(bool needReset)
             globals.cpuOverclock = newValue;
     }
 
+    var.value = NULL;
+    var.key = RENDER_THREADS_VARIABLE;
+
+    if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+    {
+        // Off renders every line as the emulation reaches it, on the emulation's own thread
+        if (!strcmp(var.value, "Auto"))
+            globals.renderThreads = VideoWorkers::automaticCount();
+        else
+            globals.renderThreads = static_cast<uint32_t>(atoi(var.value));
+
+        neocd->video.workers.resize(globals.renderThreads);
+    }
+
+    var.value = NULL;
+    var.key = SOUND_THREAD_VARIABLE;
+
+    if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+    {
+        // Off runs the Z80 on the emulation's own thread, when something needs it caught up
+        globals.soundThread = strcmp(var.value, "On") ? false : true;
+    }
+
+    // Also when the frontend has no value, so the default takes effect
+    neocd->sound.enable(globals.soundThread);
+
+    var.value = NULL;
+    var.key = IDLE_SKIP_VARIABLE;
+
+    if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+        globals.idleLoopSkip = strcmp(var.value, "On") ? false : true;
+
+    var.value = NULL;
+    var.key = BLOCK_CACHE_VARIABLE;
+
+    if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+    {
+        bool newValue = strcmp(var.value, "On") ? false : true;
+        if (globals.m68kBlockCache != newValue)
+        {
+            globals.m68kBlockCache = newValue;
+            m68k_set_block_cache(newValue);
+        }
+    }
+
     var.value = NULL;
     var.key = PER_CONTENT_SAVES_VARIABLE;
 
     if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
         globals.perContentSaves = strcmp(var.value, "On") ? false : true;
 
+    var.value = NULL;
+    var.key = LOG_LEVEL_VARIABLE;
+
+    if (libretro.environment(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+    {
+        // Anything below the level is dropped before it is formatted
+        if (!strcmp(var.value, "Info"))
+            Libretro::Log::minimumLevel = RETRO_LOG_INFO;
+        else if (!strcmp(var.value, "Warning"))
+            Libretro::Log::minimumLevel = RETRO_LOG_WARN;
+        else if (!strcmp(var.value, "Error"))
+            Libretro::Log::minimumLevel = RETRO_LOG_ERROR;
+        else
+            Libretro::Log::minimumLevel = RETRO_LOG_DEBUG;
+    }
+
     if (needReset)
         neocd->reset();
 }
@@ -1,6 +1,7 @@
 #include "3rdparty/musashi/m68k.h"
+#include "diagnostics.h"
 #include "hlebios.h"
-#include <cstdlib>
+#include <cstring>
 #include "libretro_common.h"
 #include "libretro_log.h"
 #include "m68kintf.h"
@@ -32,9 +33,8 @@ extern "C"
 
     void m68k_write_memory_8(uint32_t address, uint32_t data)
     {
-        if (getenv("W8F") && address == 0x10FD8F)
-        { static uint32_t n=0; if (n++<6) Libretro::Log::message(RETRO_LOG_INFO,
-            "10FD8F = %02X from %06X\n", data & 0xFF, m68k_get_reg(NULL, M68K_REG_PPC)); }
+        Diagnostics::checkWrite(address, 1, data);
+
         const Memory::Region* region = neocd->memory.regionLookupTable[address / Memory::MEMORY_GRANULARITY];
 
         if (!region)
@@ -46,6 +46,7 @@ extern "C"
         if (region->flags & Memory::Region::WriteDirect)
         {
             region->writeBase[address & region->addressMask] = data;
+            m68k_invalidate_code(address, 1);
             return;
         }
 
@@ -80,6 +81,8 @@ extern "C"
 
     void m68k_write_memory_16(uint32_t address, uint32_t data)
     {
+        Diagnostics::checkWrite(address, 2, data);
+
         const Memory::Region* region = neocd->memory.regionLookupTable[address / Memory::MEMORY_GRANULARITY];
 
         if (!region)
@@ -91,6 +94,7 @@ extern "C"
         if (region->flags & Memory::Region::WriteDirect)
         {
             *reinterpret_cast<uint16_t*>(&region->writeBase[address & region->addressMask]) = BIG_ENDIAN_WORD(data);
+            m68k_invalidate_code(address, 2);
             return;
         }
 
@@ -103,13 +107,44 @@ extern "C"
         // Memory::Region::WriteNop
     }
 
+    /*
+        Long words are only split in two word accesses when they are not in plain memory
+        or when the second word is in the next page, which may be mapped to something else.
+    */
     uint32_t m68k_read_memory_32(uint32_t address)
     {
+        if ((address % Memory::MEMORY_GRANULARITY) <= Memory::MEMORY_GRANULARITY - 4)
+        {
+            const Memory::Region* region = neocd->memory.regionLookupTable[address / Memory::MEMORY_GRANULARITY];
+
+            if (region && (region->flags & Memory::Region::ReadDirect))
+            {
+                uint32_t data;
+                std::memcpy(&data, &region->readBase[address & region->addressMask], sizeof(data));
+                return BIG_ENDIAN_DWORD(data);
+            }
+        }
+
         return (m68k_read_memory_16(address) << 16) | m68k_read_memory_16(address + 2);
     }
 
     void m68k_write_memory_32(uint32_t address, uint32_t data)
     {
+        if ((address % Memory::MEMORY_GRANULARITY) <= Memory::MEMORY_GRANULARITY - 4)
+        {
+            const Memory::Region* region = neocd->memory.regionLookupTable[address / Memory::MEMORY_GRANULARITY];
+
+            if (region && (region->flags & Memory::Region::WriteDirect))
+            {
+                Diagnostics::checkWrite(address, 4, data);
+
+                data = BIG_ENDIAN_DWORD(data);
+                std::memcpy(&region->writeBase[address & region->addressMask], &data, sizeof(data));
+                m68k_invalidate_code(address, 4);
+                return;
+            }
+        }
+
         m68k_write_memory_16(address, data >> 16);
         m68k_write_memory_16(address + 2, data & 0xFFFF);
     }
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <array>
 
+#include "diagnostics.h"
 #include "libretro_common.h"
 #include "libretro_log.h"
 #include "memory_backupram.h"
@@ -141,6 +142,13 @@ Memory::~Memory()
     if (ram)
         std::free(ram);
 
+    // The CPU must not keep pointers to the memory freed above
+    for (uint32_t page = 0; page < M68K_PAGE_COUNT; ++page)
+    {
+        m68k_set_read_page(page, nullptr);
+        m68k_set_write_page(page, nullptr);
+    }
+
     if (regionLookupTable)
         std::free(regionLookupTable);
 }
@@ -172,12 +180,14 @@ void Memory::reset()
 void Memory::mapVectorsToRam()
 {
     regionLookupTable[0] = &vectorRegions[Vectors::RAM];
+    mapDirectPage(0);
     vectorsMappedToRom = false;
 }
 
 void Memory::mapVectorsToRom()
 {
     regionLookupTable[0] = &vectorRegions[Vectors::ROM];
+    mapDirectPage(0);
     vectorsMappedToRom = true;
 }
 
@@ -218,6 +228,33 @@ void Memory::initializeRegionLookupTable()
         for (auto ptr = start; ptr <= end; ++ptr)
             *ptr = &memoryRegion;
     }
+
+    for (uint32_t page = 0; page < M68K_PAGE_COUNT; ++page)
+        mapDirectPage(page);
+}
+
+/*
+    Pages of plain RAM or ROM are handed to the CPU, which then reads and writes
+    them without going through m68kintf.cpp. Everything else, including the pages
+    nothing is mapped to (bus errors), is left for the region handlers.
+*/
+void Memory::mapDirectPage(uint32_t page)
+{
+    static_assert(MEMORY_GRANULARITY == M68K_PAGE_SIZE, "The CPU pages must match the lookup table");
+
+    const Memory::Region* region = regionLookupTable[page];
+    const uint32_t address = page * MEMORY_GRANULARITY;
+
+    if (region && (region->flags & Memory::Region::ReadDirect))
+        m68k_set_read_page(page, &region->readBase[address & region->addressMask]);
+    else
+        m68k_set_read_page(page, nullptr);
+
+    // Watched pages stay with m68kintf.cpp, which is where the watchpoints are checked
+    if (region && (region->flags & Memory::Region::WriteDirect) && !Diagnostics::watchesPage(page))
+        m68k_set_write_page(page, &region->writeBase[address & region->addressMask]);
+    else
+        m68k_set_write_page(page, nullptr);
 }
 
 void Memory::generateYZoomData()
@@ -342,7 +379,12 @@ uint16_t Memory::dmaFetchNextWord(const Memory::Region* region, uint32_t& offset
 void Memory::dmaWriteNextWord(const Memory::Region* region, uint32_t& offset, uint16_t data)
 {
     if (region->flags & Memory::Region::WriteDirect)
+    {
         *reinterpret_cast<uint16_t*>(&region->writeBase[offset & region->addressMask]) = BIG_ENDIAN_WORD(data);
+
+        // The 68000 may have this memory's code in its block cache
+        m68k_invalidate_code(region->startAddress + (offset & region->addressMask), 2);
+    }
     else if (region->flags & Memory::Region::WriteMapped)
         region->handlers->writeWord(offset & region->addressMask, data);
 
@@ -689,8 +731,9 @@ DataPacker& operator>>(DataPacker& in, Memory& memory)
     in.pop(reinterpret_cast<char*>(memory.paletteRam), Memory::PALETTERAM_SIZE);
     in.pop(reinterpret_cast<char*>(memory.z80Ram), Memory::Z80RAM_SIZE);
 
-    neocd->video.convertPalette();
     neocd->video.updateFixUsageMap();
+    neocd->video.invalidateFixLayer();
+    neocd->video.invalidateSpriteCache();
 
     return in;
 }
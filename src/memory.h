@@ -146,6 +146,7 @@ public:
 protected:
     void buildMemoryMap();
     void initializeRegionLookupTable();
+    void mapDirectPage(uint32_t page);
     void generateYZoomData();
 
     const Memory::Region* dmaFindRegion(uint32_t address);
@@ -1,5 +1,3 @@
-#include "3rdparty/ym/ym2610.h"
-#include "3rdparty/z80/z80.h"
 #include "libretro_common.h"
 #include "libretro_log.h"
 #include "memory_cdintf.h"
@@ -202,15 +200,27 @@ static void cdInterfaceWriteByte(uint32_t address, uint32_t data)
         break;
 
     case 0x0111:    // FF0111: SPR Layer Enable / Disable
-        neocd->video.sprDisable = (data != 0);
+        if (neocd->video.sprDisable != (data != 0))
+        {
+            neocd->video.sprDisable = (data != 0);
+            neocd->video.pictureChanged();
+        }
         break;
 
     case 0x0115:    // FF0115: FIX Layer Enable / Disable
-        neocd->video.fixDisable = (data != 0);
+        if (neocd->video.fixDisable != (data != 0))
+        {
+            neocd->video.fixDisable = (data != 0);
+            neocd->video.pictureChanged();
+        }
         break;
 
     case 0x0119:    // FF0119: Video Enable / Disable
-        neocd->video.videoEnable = (data != 0);
+        if (neocd->video.videoEnable != (data != 0))
+        {
+            neocd->video.videoEnable = (data != 0);
+            neocd->video.pictureChanged();
+        }
         break;
 
     case 0x0121:    // FF0121: SPR RAM Bus Request
@@ -277,14 +287,7 @@ static void cdInterfaceWriteByte(uint32_t address, uint32_t data)
         break;
 
     case 0x0183:    // FF0183: Z80 $00 Reset / $FF Enable
-        if (!data)
-            neocd->z80Disable = true;
-        else
-        {
-            neocd->z80Disable = false;
-            z80_reset();
-            YM2610Reset();
-        }
+        neocd->setZ80Running(data != 0);
         break;
 
     case 0x01A1:    // FF01A1: SPR RAM Bank Select
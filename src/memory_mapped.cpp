@@ -23,6 +23,8 @@ static uint32_t mappedRamReadByte(uint32_t address)
             break;
 
         case Memory::AREA_Z80:
+            // The 68000 sees the Z80's memory as it is now, not where the Z80 had got to
+            neocd->syncZ80();
             if (address & 1)
             {
                 address = ((address >> 1) & 0xFFFF);
@@ -64,6 +66,7 @@ static uint32_t mappedRamReadWord(uint32_t address)
             break;
 
         case Memory::AREA_Z80:
+            neocd->syncZ80();
             address = ((address >> 1) & 0xFFFF);
             return (neocd->memory.z80Ram[address] | 0xFF00);
             break;
@@ -101,6 +104,8 @@ static void mappedRamWriteByte(uint32_t address, uint32_t data)
                 */
                 if (data)
                     neocd->video.fixUsageMap[address >> 5] = 1;
+
+                neocd->video.fixCharacterChanged(address >> 5);
             }
             break;
 
@@ -108,9 +113,13 @@ static void mappedRamWriteByte(uint32_t address, uint32_t data)
             address += ((neocd->memory.sprBankSelect & 3) * 0x100000);
             address &= 0x3FFFFF;
             neocd->memory.sprRam[address] = data;
+
+            // The decoded copy of the tile is stale now
+            neocd->video.invalidateSpriteTile(address >> 7);
             break;
 
         case Memory::AREA_Z80:
+            neocd->syncZ80();
             if (address & 1)
             {
                 address = ((address >> 1) & 0xFFFF);
@@ -119,6 +128,8 @@ static void mappedRamWriteByte(uint32_t address, uint32_t data)
             break;
 
         case Memory::AREA_PCM:
+            // The YM2610 plays from this memory; whatever it played before the write, it played from what was there
+            neocd->syncZ80();
             if (address & 1)
             {
                 address = ((address >> 1) + ((neocd->memory.pcmBankSelect & 1) * 0x80000)) & 0xFFFFF;
@@ -144,6 +155,8 @@ static void mappedRamWriteWord(uint32_t address, uint32_t data)
             // The usage map hears about this write too, as above.
             if (data & 0xFF)
                 neocd->video.fixUsageMap[address >> 5] = 1;
+
+            neocd->video.fixCharacterChanged(address >> 5);
             break;
 
         case Memory::AREA_SPR:
@@ -151,14 +164,17 @@ static void mappedRamWriteWord(uint32_t address, uint32_t data)
             address &= 0x3FFFFE;
             wordPtr = (uint16_t*)&neocd->memory.sprRam[address];
             *wordPtr = BIG_ENDIAN_WORD(data);
+            neocd->video.invalidateSpriteTile(address >> 7);
             break;
 
         case Memory::AREA_Z80:
+            neocd->syncZ80();
             address = ((address >> 1) & 0xFFFF);
             neocd->memory.z80Ram[address] = data;
             break;
 
         case Memory::AREA_PCM:
+            neocd->syncZ80();
             address = ((address >> 1) + ((neocd->memory.pcmBankSelect & 1) * 0x80000)) & 0xFFFFF;
             neocd->memory.pcmRam[address] = data;
             break;
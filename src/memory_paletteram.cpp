@@ -14,16 +14,25 @@ static uint32_t paletteRamReadWord(uint32_t address)
 
 static void paletteRamWriteByte(uint32_t address, uint32_t data)
 {
-    uint32_t color = (neocd->video.activePaletteBank * 4096) + (address / 2);
-    *(reinterpret_cast<uint8_t*>(&neocd->memory.paletteRam[neocd->video.activePaletteBank * 4096]) + address) = data;
-    neocd->video.convertColor(color);
+    uint8_t& byte = *(reinterpret_cast<uint8_t*>(&neocd->memory.paletteRam[neocd->video.activePaletteBank * 4096]) + address);
+
+    if (byte != static_cast<uint8_t>(data))
+    {
+        neocd->video.pictureMemoryWrite();
+        byte = data;
+    }
 }
 
 static void paletteRamWriteWord(uint32_t address, uint32_t data)
 {
-    uint32_t color = (neocd->video.activePaletteBank * 4096) + (address / 2);
-    neocd->memory.paletteRam[color] = BIG_ENDIAN_WORD(data);
-    neocd->video.convertColor(color);
+    uint16_t& word = neocd->memory.paletteRam[(neocd->video.activePaletteBank * 4096) + (address / 2)];
+
+    // Palette fades rewrite every entry each frame, most of them unchanged
+    if (word != BIG_ENDIAN_WORD(data))
+    {
+        neocd->video.pictureMemoryWrite();
+        word = BIG_ENDIAN_WORD(data);
+    }
 }
 
 const Memory::Handlers paletteRamHandlers = {
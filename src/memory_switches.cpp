@@ -18,6 +18,24 @@ static uint32_t switchReadWord(uint32_t address)
     return 0xFFFF;
 }
 
+static void setShadow(bool shadow)
+{
+    if (neocd->video.shadow != shadow)
+    {
+        neocd->video.shadow = shadow;
+        neocd->video.pictureChanged();
+    }
+}
+
+static void setPaletteBank(uint32_t bank)
+{
+    if (neocd->video.activePaletteBank != bank)
+    {
+        neocd->video.activePaletteBank = bank;
+        neocd->video.pictureChanged();
+    }
+}
+
 /*
     The vector area affected by the switch is 0x80 bytes.
     When ROM is mapped to address 0, writing to the area has no effect.
@@ -27,19 +45,11 @@ static void switchWriteWord(uint32_t address, uint32_t data)
     switch (address)
     {
     case 0x00:  // REG_NOSHADOW: normal brightness
-        if (neocd->video.shadow)
-        {
-            neocd->video.shadow = false;
-            neocd->video.convertPalette();
-        }
+        setShadow(false);
         break;
 
     case 0x10:  // REG_SHADOW: darken the whole screen
-        if (!neocd->video.shadow)
-        {
-            neocd->video.shadow = true;
-            neocd->video.convertPalette();
-        }
+        setShadow(true);
         break;
 
     case 0x02:  // Set ROM vectors
@@ -47,7 +57,7 @@ static void switchWriteWord(uint32_t address, uint32_t data)
         break;
 
     case 0x0e:  // Set Palette bank 0
-        neocd->video.activePaletteBank = 0;
+        setPaletteBank(0);
         break;
 
     case 0x12:  // Set RAM vectors
@@ -55,7 +65,7 @@ static void switchWriteWord(uint32_t address, uint32_t data)
         break;
 
     case 0x1e:  // Set palette bank 1
-        neocd->video.activePaletteBank = 1;
+        setPaletteBank(1);
         break;
 
     default:    // unknown
@@ -49,10 +49,20 @@ static void videoRamWriteWord(uint32_t address, uint32_t data)
         */
         if (neocd->video.videoramOffset < 0x8800)
         {
-            neocd->memory.videoRam[neocd->video.videoramOffset] = data;
-            if ((neocd->video.videoramOffset & 0xFE00) >= 0x8000
-                && (neocd->video.videoramOffset & 0xFE00) < 0x8600)
-                neocd->video.spriteIndexDirty = true;
+            uint16_t& word = neocd->memory.videoRam[neocd->video.videoramOffset];
+
+            // Games rewrite the whole attribute table every frame; a word
+            // that comes back the same moves nothing.
+            if (word != data)
+            {
+                neocd->video.pictureMemoryWrite();
+                word = data;
+                if ((neocd->video.videoramOffset & 0xFE00) >= 0x8000
+                    && (neocd->video.videoramOffset & 0xFE00) < 0x8600)
+                    neocd->video.spriteAttributesChanged(neocd->video.videoramOffset & 0x1FF);
+                else if ((neocd->video.videoramOffset >= 0x7000) && (neocd->video.videoramOffset < 0x7500))
+                    neocd->video.fixMapChanged(neocd->video.videoramOffset);
+            }
         }
         neocd->video.videoramOffset = (neocd->video.videoramOffset & 0x8000) | ((neocd->video.videoramOffset + neocd->video.videoramModulo) & 0x7FFF);
         neocd->video.videoramData = neocd->memory.videoRam[neocd->video.videoramOffset];
@@ -64,7 +74,11 @@ static void videoRamWriteWord(uint32_t address, uint32_t data)
 
     case    0x6:    // $3C0006: Auto animation speed & H IRQ control
         neocd->video.autoAnimationSpeed = data >> 8;
-        neocd->video.autoAnimationDisabled = (data & 0x0008) != 0;
+        if (neocd->video.autoAnimationDisabled != ((data & 0x0008) != 0))
+        {
+            neocd->video.autoAnimationDisabled = (data & 0x0008) != 0;
+            neocd->video.pictureChanged();
+        }
         neocd->video.hirqControl = data & 0x00F0;
         break;
 
@@ -10,13 +10,18 @@ extern "C"
 static uint32_t z80CommunicationReadByte(uint32_t address)
 {
     if (!address)
+    {
+        // The Z80 runs behind, and may have written its reply since it last ran
+        neocd->syncZ80();
         return neocd->audioResult;
+    }
 
     return 0xFF;
 }
 
 static uint32_t z80CommunicationReadWord(uint32_t address)
 {
+    neocd->syncZ80();
     return (neocd->audioResult << 8) | 0xFF;
 }
 
@@ -3,6 +3,7 @@
 #include "3rdparty/ym/ym2610.h"
 #include "3rdparty/z80/z80.h"
 #include "hlebios.h"
+#include "idleloop.h"
 #include "libretro_common.h"
 #include "m68kintf.h"
 #include "neogeocd.h"
@@ -16,6 +17,8 @@ extern "C"
     #include "3rdparty/musashi/m68kcpu.h"
 }
 
+static int m68kTimesliceCallback(int cyclesUsed);
+
 NeoGeoCD::NeoGeoCD() :
     memory(),
     video(),
@@ -24,6 +27,7 @@ NeoGeoCD::NeoGeoCD() :
     timers(),
     input(),
     audio(),
+    sound(*this),
     cdzIrq1Divisor(0),
     cdCommunicationNReset(false),
     irqMask1(0),
@@ -35,6 +39,11 @@ NeoGeoCD::NeoGeoCD() :
     pendingInterrupts(0),
     remainingCyclesThisFrame(0),
     z80TimeSlice(0),
+    z80BoundaryTimeCycles(0),
+    z80BoundaryRemainingCycles(0),
+    z80Slices(),
+    z80SlicesCycles(0),
+    z80RunCycles(0),
     cpuOverclockCarry(0),
     z80Disable(true),
     z80NMIDisable(true),
@@ -42,6 +51,9 @@ NeoGeoCD::NeoGeoCD() :
     audioCommand(0),
     audioResult(0),
     biosType(Bios::Unknown),
+    idleCyclesThisFrame(0),
+    idleCyclesLastFrame(0),
+    z80IdleCyclesLastFrame(0),
     usingHleBios(false)
 {
     // Create the worker thread to buffer & decode audio data
@@ -59,10 +71,13 @@ void NeoGeoCD::initialize()
     // Initialize the 68000 emulation core
     m68k_set_cpu_type(M68K_CPU_TYPE_68000);
     m68k_init();
+    m68k_set_block_cache(globals.m68kBlockCache);
+    m68k_set_timeslice_callback(m68kTimesliceCallback);
 
 
     // Inizialize the z80 core
     z80_init(0, Timer::Z80_CLOCK, NULL, z80_irq_callback);
+    z80_set_memory(memory.z80Ram);
 
     // Initialize the YM2610
     YM2610Init(8000000, Audio::SAMPLE_RATE, memory.pcmRam, Memory::PCMRAM_SIZE, YM2610TimerHandler, YM2610IrqHandler);
@@ -77,6 +92,8 @@ void NeoGeoCD::deinitialize()
 
 void NeoGeoCD::reset()
 {
+    video.finishLines();
+    sound.finish();
     memory.reset();
     video.reset();
     cdrom.reset();
@@ -93,6 +110,11 @@ void NeoGeoCD::reset()
     irqMask2 = 0;
     remainingCyclesThisFrame = 0;
     z80TimeSlice = 0;
+    z80BoundaryTimeCycles = 0;
+    z80BoundaryRemainingCycles = 0;
+    z80Slices.clear();
+    z80SlicesCycles = 0;
+    z80RunCycles = 0;
     cpuOverclockCarry = 0;
     z80Disable = true;
     z80NMIDisable = true;
@@ -100,7 +122,13 @@ void NeoGeoCD::reset()
     fastForward = false;
     audioCommand = 0;
     audioResult = 0;
+    idleCyclesThisFrame = 0;
+    idleCyclesLastFrame = 0;
+    z80IdleCyclesLastFrame = 0;
+    z80_idle_cycles = 0;
 
+    // Memory has been wiped and the BIOS may have changed under the 68000's block cache
+    m68k_invalidate_code(0, 0x1000000);
     m68k_pulse_reset();
     z80_reset();
     YM2610Reset();
@@ -108,12 +136,26 @@ void NeoGeoCD::reset()
 
 static bool g_m68kMidSlice = false;
 
+// 68000 cycles run by the earlier m68k_execute calls a timeslice was split into
+static int32_t g_m68kSliceDone = 0;
+
+// Set while the 68000 runs what is left of a timeslice, which it can carry on past
+static bool g_m68kSliceOpen = false;
+
+// Set once the timeslice callback has ended the slice runM68k was called for
+static bool g_m68kSliceEnded = false;
+
+static int32_t m68kSliceCyclesRun()
+{
+    return g_m68kSliceDone + m68k_cycles_run();
+}
+
 int32_t NeoGeoCD::midSliceElapsed() const
 {
     if (!g_m68kMidSlice)
         return 0;
 
-    int32_t elapsed = Timer::m68kToMaster(m68k_cycles_run());
+    int32_t elapsed = Timer::m68kToMaster(m68kSliceCyclesRun());
     uint32_t overclock = globals.cpuOverclock;
 
     // Under overclock the processor's cycles cover proportionally less
@@ -124,69 +166,187 @@ int32_t NeoGeoCD::midSliceElapsed() const
     return elapsed;
 }
 
+int32_t NeoGeoCD::sliceRequest() const
+{
+    uint32_t timeSlice = std::min(timers.timeSlice(), remainingCyclesThisFrame);
+    uint32_t overclock = globals.cpuOverclock;
+    int32_t  request   = Timer::masterToM68k(timeSlice);
+
+    if (overclock != 100)
+        request = std::max(INT32_C(1), (int32_t)(((int64_t)request * overclock) / 100));
+
+    return request;
+}
+
+void NeoGeoCD::endSlice(int32_t executed)
+{
+    uint32_t overclock = globals.cpuOverclock;
+    uint32_t elapsed;
+
+    if (overclock != 100)
+    {
+        // Exact accounting: the processor ran executed cycles at
+        // overclock/100 times the stock rate, so it consumed
+        // executed * 100 / overclock of wall time. The division
+        // remainder is carried so no time is created or lost over
+        // the long run. The carry stays out of the saved state -
+        // it is a fraction of a cycle - but it lives with the rest
+        // of the frame accounting so that reset clears it and a
+        // restore begins from zero.
+        uint64_t t = (uint64_t)Timer::m68kToMaster(executed) * 100
+                   + cpuOverclockCarry;
+        elapsed = (uint32_t)(t / overclock);
+        cpuOverclockCarry = (uint32_t)(t % overclock);
+
+        if (!elapsed && executed > 0)
+            elapsed = 1;
+    }
+    else
+        elapsed = Timer::m68kToMaster(executed);
+
+
+    // The Z80 falls that much further behind; syncZ80 catches it up when something needs it
+    sound.post(SoundThread::Advance, elapsed);
+
+    remainingCyclesThisFrame -= elapsed;
+    currentTimeCycles += (uint64_t)elapsed;
+
+    timers.advanceTime(elapsed);
+}
+
+/*
+    Most slices end on a timer whose callback the processor cannot tell from
+    the outside - the line timer drawing a line, the audio command reaching
+    the Z80 - so rather than come back out of m68k_execute for
+    each of them, the slice is ended from the core's timeslice callback, in the
+    same place between the same two instructions, and the core goes straight on
+    with the next one. It comes back out when there is something only a new
+    m68k_execute can do: take an interrupt, eat reset cycles or wait stopped.
+    The frame ending and an idle loop runM68k could skip also bring it back.
+*/
+int32_t NeoGeoCD::continueSlice(int32_t executed)
+{
+    g_m68kMidSlice = false;
+    endSlice(executed);
+    g_m68kSliceEnded = true;
+
+    if (remainingCyclesThisFrame <= 0)
+        return 0;
+
+    if (globals.idleLoopSkip && IdleLoop::recognise(memory, m68k_get_reg(nullptr, M68K_REG_PC)))
+        return 0;
+
+    g_m68kSliceDone = 0;
+    g_m68kMidSlice = true;
+    return sliceRequest();
+}
+
+static int m68kTimesliceCallback(int cyclesUsed)
+{
+    // Only a run to the end of the slice can go on into the next one
+    if (!g_m68kSliceOpen)
+        return 0;
+
+    return neocd->continueSlice(g_m68kSliceDone + cyclesUsed);
+}
+
+// Run the 68000 to the end of the slice, and past it for as long as continueSlice lets it
+static int32_t m68kExecuteOpen(int32_t request)
+{
+    g_m68kSliceOpen = true;
+    int32_t executed = m68k_execute(request);
+    g_m68kSliceOpen = false;
+    return executed;
+}
+
 void NeoGeoCD::runOneFrame()
 {
 
     remainingCyclesThisFrame += Timer::CYCLES_PER_FRAME;
+    sound.post(SoundThread::NewFrame);
 
     audio.initFrame();
 
     while (remainingCyclesThisFrame > 0)
     {
-        uint32_t timeSlice = std::min(timers.timeSlice(), remainingCyclesThisFrame);
-        uint32_t overclock = globals.cpuOverclock;
-        int32_t  request   = Timer::masterToM68k(timeSlice);
-        uint32_t elapsed;
-
-        if (overclock != 100)
-            request = std::max(INT32_C(1), (int32_t)(((int64_t)request * overclock) / 100));
+        g_m68kSliceEnded = false;
 
         g_m68kMidSlice = true;
-        int32_t executed = m68k_execute(request);
+        int32_t executed = runM68k(sliceRequest());
         g_m68kMidSlice = false;
 
-        if (overclock != 100)
-        {
-            // Exact accounting: the processor ran executed cycles at
-            // overclock/100 times the stock rate, so it consumed
-            // executed * 100 / overclock of wall time. The division
-            // remainder is carried so no time is created or lost over
-            // the long run. The carry stays out of the saved state -
-            // it is a fraction of a cycle - but it lives with the rest
-            // of the frame accounting so that reset clears it and a
-            // restore begins from zero.
-            uint64_t t = (uint64_t)Timer::m68kToMaster(executed) * 100
-                       + cpuOverclockCarry;
-            elapsed = (uint32_t)(t / overclock);
-            cpuOverclockCarry = (uint32_t)(t % overclock);
-
-            if (!elapsed && executed > 0)
-                elapsed = 1;
-        }
-        else
-            elapsed = Timer::m68kToMaster(executed);
+        // Unless the timeslice callback has already ended it
+        if (!g_m68kSliceEnded)
+            endSlice(executed);
+    }
 
+    // The sound is mixed from what the Z80 did, so it has to have done all of it
+    syncZ80();
 
-        z80TimeSlice += elapsed;
-        if (z80TimeSlice > 0)
-        {
-            uint32_t z80Elapsed;
+    idleCyclesLastFrame = idleCyclesThisFrame;
+    idleCyclesThisFrame = 0;
 
-            if (z80Disable)
-                z80Elapsed = z80TimeSlice;
-            else
-                z80Elapsed = Timer::z80ToMaster(z80_execute(Timer::masterToZ80(z80TimeSlice)));
+    z80IdleCyclesLastFrame = z80_idle_cycles;
+    z80_idle_cycles = 0;
 
-            z80TimeSlice -= z80Elapsed;
-        }
+    // The picture goes out once the frame is run, so every line of it has to be in
+    video.finishLines();
+
+    audio.finalize();
+}
+
+/*
+    A game waiting for the vertical blank spends most of the frame going round a
+    loop like the ones IdleLoop recognises. Nothing it reads can change before
+    the slice ends, and no interrupt can arrive before then either, so every pass
+    costs the same cycles and leaves the processor exactly as it found it.
+
+    The loop is first gone round once an instruction at a time, within the
+    request just as m68k_execute would, which both proves the branch is taken and
+    gives the cost of a pass. As many whole passes as fit strictly inside what is
+    left are then counted without being run, and m68k_execute runs the rest: the
+    instructions executed, the cycles billed and the overshoot at the end are the
+    same as if the whole slice had been run.
+*/
+int32_t NeoGeoCD::runM68k(int32_t request)
+{
+    g_m68kSliceDone = 0;
 
-        remainingCyclesThisFrame -= elapsed;
-        currentTimeCycles += (uint64_t)elapsed;
+    if (!globals.idleLoopSkip)
+        return m68kExecuteOpen(request);
 
-        timers.advanceTime(elapsed);
+    // Interrupts are only taken when an execution starts; one waiting would end the loop
+    if (CPU_STOPPED || RESET_CYCLES || FLAG_T1 || m68ki_cpu.nmi_pending || (CPU_INT_LEVEL > FLAG_INT_MASK))
+        return m68kExecuteOpen(request);
+
+    const uint32_t loop = m68k_get_reg(nullptr, M68K_REG_PC);
+
+    if (!IdleLoop::recognise(memory, loop))
+        return m68kExecuteOpen(request);
+
+    int32_t done = 0;
+
+    // Once round: the test, then the branch
+    for (int i = 0; (i < 2) && (done < request); ++i)
+    {
+        g_m68kSliceDone = done;
+        done += m68k_execute(1);
     }
 
-    audio.finalize();
+    if (done >= request)
+        return done;
+
+    if (m68k_get_reg(nullptr, M68K_REG_PC) == loop)
+    {
+        const int32_t pass = done;
+        const int32_t skipped = ((request - done - 1) / pass) * pass;
+
+        done += skipped;
+        idleCyclesThisFrame += skipped;
+    }
+
+    g_m68kSliceDone = done;
+    return done + m68kExecuteOpen(request - done);
 }
 
 void NeoGeoCD::setInterrupt(NeoGeoCD::Interrupt interrupt)
@@ -251,22 +411,165 @@ int NeoGeoCD::updateInterrupts(void)
 
 int32_t NeoGeoCD::m68kMasterCyclesThisFrame() const
 {
-    return Timer::CYCLES_PER_FRAME - remainingCyclesThisFrame + Timer::m68kToMaster(m68k_cycles_run());
+    return Timer::CYCLES_PER_FRAME - remainingCyclesThisFrame + Timer::m68kToMaster(m68kSliceCyclesRun());
+}
+
+/*
+    The Z80 is not run after every 68000 timeslice. It runs behind, by the
+    slices in z80Slices, and is caught up only when something is
+    about to look at it or change what it sees - the 68000 reading its reply
+    or its memory, a sound command reaching it, its reset line moving - and
+    at the end of the frame, before the sound is mixed. It is caught up to
+    the last slice boundary, which is as far as it ever got before, so the
+    68000 finds it in the same place it used to.
+
+    The two YM2610 timers go on with the Z80 rather than the 68000, which
+    no longer has its slices cut short by them, so the interrupt one raises
+    reaches the Z80 where it always did however far behind it is.
+
+    All of that happens on the sound side, which is handed each slice
+    boundary, sound command and reset as SoundThread events and may be on a
+    thread of its own. Whoever calls this waits for it to be done.
+*/
+void NeoGeoCD::syncZ80()
+{
+    sound.sync();
+}
+
+void NeoGeoCD::sendAudioCommand(uint32_t command)
+{
+    // The Z80 has to be where the command finds it
+    sound.post(SoundThread::Sync);
+    sound.post(SoundThread::Command, static_cast<int32_t>(command));
+}
+
+void NeoGeoCD::setZ80Running(bool running)
+{
+    // Up to now the Z80 ran, or did not, as it was
+    sound.post(SoundThread::Sync);
+    sound.post(SoundThread::Reset, running ? 1 : 0);
+}
+
+void NeoGeoCD::soundEvent(const SoundThread::Event& event, bool ahead)
+{
+    switch (event.type)
+    {
+    case SoundThread::Advance:
+        z80Slices.push_back(event.value);
+        z80SlicesCycles += event.value;
+        z80BoundaryTimeCycles += (uint64_t)event.value;
+        z80BoundaryRemainingCycles -= event.value;
+
+        // The thread need not wait for a sync to run what a sync would run first
+        if (ahead)
+            runZ80();
+        break;
+
+    case SoundThread::NewFrame:
+        z80BoundaryRemainingCycles += Timer::CYCLES_PER_FRAME;
+        break;
+
+    case SoundThread::Sync:
+        runZ80();
+        break;
+
+    case SoundThread::Command:
+        // Post the audio command to the Z80
+        audioCommand = static_cast<uint32_t>(event.value);
+
+        // If the NMI is not disabled
+        if (!z80NMIDisable)
+        {
+            // Trigger it
+            z80_set_irq_line(INPUT_LINE_NMI, ASSERT_LINE);
+            z80_set_irq_line(INPUT_LINE_NMI, CLEAR_LINE);
+        }
+        break;
+
+    case SoundThread::Reset:
+        if (!event.value)
+            z80Disable = true;
+        else
+        {
+            z80Disable = false;
+            z80_reset();
+            YM2610Reset();
+        }
+        break;
+    }
+}
+
+/*
+    The slices are gone through one at a time, as the Z80 used to be run
+    after each of them, and one a YM2610 timer expires in is cut short
+    there, as the 68000's slices used to be. Each step runs the Z80 to its
+    end and only then moves the timers on by the whole of it, so a timer the
+    Z80 arms counts from the start of the step it is armed in, and one that
+    expires reloads from the end of the step: the timers keep the timing
+    they always had. Where the steps fall does not depend on when they are
+    run, so the sound thread runs each slice as it arrives and a sync runs
+    whatever has gathered, and the sound is the same either way.
+*/
+void NeoGeoCD::runZ80()
+{
+    Timer& timerA = timers.timer<TimerGroup::Ym2610A>();
+    Timer& timerB = timers.timer<TimerGroup::Ym2610B>();
+
+    while (!z80Slices.empty())
+    {
+        int32_t step = z80Slices.front();
+
+        if (timerA.isActive())
+            step = std::min(step, timerA.delay());
+
+        if (timerB.isActive())
+            step = std::min(step, timerB.delay());
+
+        if (step == z80Slices.front())
+            z80Slices.pop_front();
+        else
+            z80Slices.front() -= step;
+
+        z80SlicesCycles -= step;
+        z80TimeSlice += step;
+
+        if (z80TimeSlice > 0)
+        {
+            int32_t z80Elapsed;
+
+            if (z80Disable)
+                z80Elapsed = z80TimeSlice;
+            else
+            {
+                z80RunCycles = Timer::masterToZ80(z80TimeSlice);
+                z80Elapsed = Timer::z80ToMaster(z80_execute(z80RunCycles));
+                z80RunCycles = 0;
+            }
+
+            z80TimeSlice -= z80Elapsed;
+        }
+
+        timerA.advanceTime(step);
+        timerB.advanceTime(step);
+    }
 }
 
 int32_t NeoGeoCD::z80CyclesRun() const
 {
-   return z80TimeSlice - Timer::z80ToMaster(z80_ICount);
+    if (!z80RunCycles)
+        return 0;
+
+    return Timer::z80ToMaster(z80RunCycles - z80_ICount);
 }
 
 uint64_t NeoGeoCD::z80CurrentTimeCycles() const
 {
-    return currentTimeCycles + (uint64_t)z80CyclesRun();
+    return (uint64_t)((int64_t)z80BoundaryTimeCycles - z80SlicesCycles - z80TimeSlice + z80CyclesRun());
 }
 
 int32_t NeoGeoCD::z80CyclesThisFrame() const
 {
-    return Timer::CYCLES_PER_FRAME - remainingCyclesThisFrame + z80CyclesRun();
+    return Timer::CYCLES_PER_FRAME - z80BoundaryRemainingCycles - z80SlicesCycles - z80TimeSlice + z80CyclesRun();
 }
 
 bool NeoGeoCD::saveState(DataPacker& out) const
@@ -327,6 +630,9 @@ bool NeoGeoCD::saveState(DataPacker& out) const
 
 bool NeoGeoCD::restoreState(DataPacker& in)
 {
+    video.finishLines();
+    sound.finish();
+
     // General machine state
     in >> cdzIrq1Divisor;
     in >> cdCommunicationNReset;
@@ -346,17 +652,21 @@ bool NeoGeoCD::restoreState(DataPacker& in)
     in >> audioResult;
     in >> biosType;
 
+    z80BoundaryTimeCycles = currentTimeCycles;
+    z80BoundaryRemainingCycles = remainingCyclesThisFrame;
+    z80Slices.clear();
+    z80SlicesCycles = 0;
+
     HleBios::restoreState(in);
 
     // M68K
     in >> m68ki_cpu;
-    m68k_set_cpu_type(M68K_CPU_TYPE_68000);
     // The whole core struct is restored from the state, including its host
-    // callback pointers. m68k_set_cpu_type above already restores the two
-    // cycle-table pointers; clear every callback so a stale or hostile state
-    // can never leave one pointing at an address of its choosing. The four
-    // in the middle are unused in this build's config, but are cleared too
-    // so enabling one later cannot turn a restore into an arbitrary call.
+    // callback pointers and two cycle-table pointers the core no longer
+    // reads. Clear every callback so a stale or hostile state can never
+    // leave one pointing at an address of its choosing. The four in the
+    // middle are unused in this build's config, but are cleared too so
+    // enabling one later cannot turn a restore into an arbitrary call.
     m68ki_cpu.int_ack_callback = nullptr;
     m68ki_cpu.bkpt_ack_callback = nullptr;
     m68ki_cpu.reset_instr_callback = nullptr;
@@ -382,8 +692,9 @@ bool NeoGeoCD::restoreState(DataPacker& in)
     // Timers
     in >> timers;
 
-    // Memory
+    // Memory, none of which the block cache has seen
     in >> memory;
+    m68k_invalidate_code(0, 0x1000000);
 
     // Video
     in >> video;
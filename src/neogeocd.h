@@ -2,6 +2,7 @@
 #define NEOGEOCD_H
 
 #include <cstddef>
+#include <deque>
 
 #include "audio.h"
 #include "bios.h"
@@ -11,6 +12,7 @@
 #include "lc8951.h"
 #include "memory.h"
 #include "misc.h"
+#include "sound_thread.h"
 #include "timergroup.h"
 #include "video.h"
 
@@ -49,6 +51,18 @@ public:
     void reset();
     void runOneFrame();
 
+    /// Run the 68000 for a timeslice, skipping whole passes of an idle loop it is waiting in
+    int32_t runM68k(int32_t request);
+
+    /// 68000 cycles of the next timeslice, up to the first timer or the end of the frame
+    int32_t sliceRequest() const;
+
+    /// Account for a timeslice the 68000 ran executed cycles of: leave the Z80 that much further behind and advance the timers
+    void endSlice(int32_t executed);
+
+    /// End the slice that ran executed 68000 cycles from inside the 68000, returning the next one to go on with or zero
+    int32_t continueSlice(int32_t executed);
+
     void setInterrupt(NeoGeoCD::Interrupt interrupt);
     void clearInterrupt(NeoGeoCD::Interrupt interrupt);
     int  updateInterrupts();
@@ -110,6 +124,23 @@ public:
 
     int32_t m68kMasterCyclesThisFrame() const;
 
+    /// Run the Z80 up to the last timeslice boundary, and the YM2610 timers along with it,
+    /// and wait for the sound side to be done before looking at it or changing it
+    void syncZ80();
+
+    /// Have the sound command reach the Z80 once it has caught up
+    void sendAudioCommand(uint32_t command);
+
+    /// Hold the Z80 in reset, or let it go from reset, once it has caught up
+    void setZ80Running(bool running);
+
+    /// Handle an event posted to the sound side; ahead is set on the sound thread
+    void soundEvent(const SoundThread::Event& event, bool ahead);
+
+    /// Run the Z80 through the slices handed to the sound side, and the YM2610 timers along with it
+    void runZ80();
+
+    /// Master cycles the Z80 has run so far in the run it is in, or zero outside one
     int32_t z80CyclesRun() const;
 
     uint64_t z80CurrentTimeCycles() const;
@@ -126,6 +157,7 @@ public:
     TimerGroup timers;
     Input input;
     Audio audio;
+    SoundThread sound;
 
     // Variables to save in savestate
     uint32_t    cdzIrq1Divisor;
@@ -138,7 +170,28 @@ public:
     uint32_t    cdromVector;
     uint32_t    pendingInterrupts;
     int32_t     remainingCyclesThisFrame;
+    /// Master cycles the Z80 is behind the YM2610 timers; negative when it has run past them
     int32_t     z80TimeSlice;
+    /* The last timeslice boundary the sound side has heard of, as master
+       cycles since power on and cycles left in the frame: currentTimeCycles
+       and remainingCyclesThisFrame as they were then. The sound thread
+       reads these rather than the 68000's, which have moved on. Not in the
+       saved state: they are the same as those two whenever it is saved.
+    */
+    uint64_t    z80BoundaryTimeCycles;
+    int32_t     z80BoundaryRemainingCycles;
+    /* Slices, in master cycles, the sound side has been handed and the
+       YM2610 timers have not yet been through, oldest first, and their
+       total. Not in the saved state: every frame ends with a sync, which
+       leaves none.
+    */
+    std::deque<int32_t> z80Slices;
+    int32_t     z80SlicesCycles;
+    /* Z80 cycles the run in progress was asked for, zero outside one.
+       Not in the saved state: the Z80 is never stopped in the middle of
+       a run to save it.
+    */
+    int32_t     z80RunCycles;
     /* Remainder of the overclock division, in hundredths of a master
        cycle, carried from one timeslice into the next so the scaling
        neither creates nor loses time. Deliberately not in the saved
@@ -160,6 +213,15 @@ public:
     uint32_t    biosType;
     // End variables to save in savestate
 
+    /// 68000 cycles skipped in idle loops so far this frame, and over the whole
+    /// of the last one. Not saved: skipping changes nothing but the time it takes.
+    uint32_t    idleCyclesThisFrame;
+    uint32_t    idleCyclesLastFrame;
+
+    /// Z80 cycles HALT and the poll loop shortcuts skipped over the whole of the
+    /// last frame. Not saved, for the same reason.
+    uint32_t    z80IdleCyclesLastFrame;
+
     /// True when no BIOS file was found and the stand-in is in use.
     /// Not saved: it follows from how the core was started, not from
     /// where the machine has got to.
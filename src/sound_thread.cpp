@@ -0,0 +1,215 @@
+#include "neogeocd.h"
+#include "sound_thread.h"
+
+SoundThread::SoundThread(NeoGeoCD& machine) :
+    machine(machine)
+{
+}
+
+SoundThread::~SoundThread()
+{
+    enable(false);
+}
+
+#ifdef HAVE_THREADS
+
+void SoundThread::enable(bool on)
+{
+    if (on == thread.joinable())
+        return;
+
+    if (on)
+    {
+        thread = std::thread(&SoundThread::work, this);
+        return;
+    }
+
+    finish();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        woken = true;
+    }
+
+    wake.notify_one();
+    thread.join();
+
+    stopping = false;
+    woken = false;
+    sleeping = false;
+    unwokenCycles = 0;
+}
+
+bool SoundThread::enabled() const
+{
+    return thread.joinable();
+}
+
+void SoundThread::post(EventType type, int32_t value)
+{
+    const Event event = { type, value };
+
+    if (!thread.joinable())
+    {
+        machine.soundEvent(event, false);
+        return;
+    }
+
+    const uint32_t tail = queueTail.load(std::memory_order_relaxed);
+
+    // The thread is a queue's worth behind, and nothing but letting it run will help
+    while (tail - queueHead.load(std::memory_order_acquire) == QUEUE_SIZE)
+    {
+        wakeThread();
+        std::this_thread::yield();
+    }
+
+    queue[tail % QUEUE_SIZE] = event;
+    queueTail.store(tail + 1);
+
+    // Awake, the thread looks at the queue again before it sleeps, and finds this
+    if (!sleeping.load())
+    {
+        unwokenCycles = 0;
+        return;
+    }
+
+    // A slice boundary is rarely enough for it to run anything; let a few gather
+    if (type == Advance)
+    {
+        unwokenCycles += value;
+
+        if (unwokenCycles < WAKE_CYCLES)
+            return;
+    }
+
+    unwokenCycles = 0;
+    wakeThread();
+}
+
+void SoundThread::sync()
+{
+    // With the thread asleep over an empty queue, the caller does the waiting part itself
+    if (!thread.joinable() || idle())
+    {
+        machine.soundEvent({ Sync, 0 }, false);
+        return;
+    }
+
+    post(Sync);
+    finish();
+}
+
+void SoundThread::finish()
+{
+    if (!thread.joinable() || idle())
+        return;
+
+    // Boundaries it was never woken for are waiting too
+    if (sleeping.load())
+        wakeThread();
+
+    // What is left is usually done sooner than a sleep and a wake up would take
+    for (uint32_t i = 0; i < SPIN_COUNT; ++i)
+    {
+        if (idle())
+            return;
+
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return idle(); });
+}
+
+void SoundThread::wakeThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        woken = true;
+    }
+
+    wake.notify_one();
+}
+
+bool SoundThread::idle() const
+{
+    // The thread moves the head on once it is done with an event, not before
+    return queueHead.load() == queueTail.load();
+}
+
+void SoundThread::work()
+{
+    uint32_t spins = 0;
+
+    for (;;)
+    {
+        const uint32_t head = queueHead.load(std::memory_order_relaxed);
+
+        if (head != queueTail.load(std::memory_order_acquire))
+        {
+            machine.soundEvent(queue[head % QUEUE_SIZE], true);
+            queueHead.store(head + 1);
+            spins = 0;
+            continue;
+        }
+
+        // The next event is often on its way already; sleeping costs more than waiting a little for it
+        if (spins < SPIN_COUNT)
+        {
+            ++spins;
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // Whatever is posted from here on either is seen below or sees this and wakes the thread
+        sleeping.store(true);
+
+        if (queueHead.load() != queueTail.load())
+        {
+            sleeping.store(false);
+            continue;
+        }
+
+        drained.notify_all();
+        wake.wait(lock, [this] { return woken; });
+        woken = false;
+
+        if (stopping)
+            return;
+
+        sleeping.store(false);
+        spins = 0;
+    }
+}
+
+#else // HAVE_THREADS
+
+void SoundThread::enable(bool on)
+{
+    (void)on;
+}
+
+bool SoundThread::enabled() const
+{
+    return false;
+}
+
+void SoundThread::post(EventType type, int32_t value)
+{
+    machine.soundEvent({ type, value }, false);
+}
+
+void SoundThread::sync()
+{
+    machine.soundEvent({ Sync, 0 }, false);
+}
+
+void SoundThread::finish()
+{
+}
+
+#endif // HAVE_THREADS
@@ -0,0 +1,111 @@
+#ifndef SOUND_THREAD_H
+#define SOUND_THREAD_H
+
+#include <cstdint>
+
+#include "timer.h"
+
+#ifdef HAVE_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+class NeoGeoCD;
+
+/*
+    The Z80 and the YM2610, run on a thread of their own while the 68000
+    goes on with the frame. The emulation hands it what happens to the
+    sound side, in the order it happens, through a queue only the two
+    threads touch and neither ever locks: slice boundaries the Z80 may
+    run up to, the points where the Z80 must have caught up, sound
+    commands, and its reset line. Anything that looks at or changes the
+    sound side directly - the 68000 reading the Z80's reply or its
+    memory, the end of the frame - calls sync(), which returns once the
+    thread has handled everything posted so far.
+
+    The thread runs exactly the Z80 executions the emulation would have
+    run itself, in the same order and of the same lengths, so the sound
+    comes out the same with it or without it. With no thread - when it
+    is turned off, and all there is in a build without HAVE_THREADS -
+    every event is handled where it is posted.
+*/
+class SoundThread
+{
+public:
+    enum EventType
+    {
+        /// The 68000 has run value more master cycles
+        Advance,
+        /// A new frame has begun
+        NewFrame,
+        /// The Z80 must be caught up to the last slice boundary
+        Sync,
+        /// Sound command value reaches the Z80
+        Command,
+        /// Value reaches the Z80's reset line
+        Reset
+    };
+
+    struct Event
+    {
+        EventType type;
+        int32_t   value;
+    };
+
+    explicit SoundThread(NeoGeoCD& machine);
+    ~SoundThread();
+
+    // Non copyable
+    SoundThread(const SoundThread&) = delete;
+
+    // Non copyable
+    SoundThread& operator=(const SoundThread&) = delete;
+
+    /// Start the thread, or stop it and handle everything on the emulation's own
+    void enable(bool on);
+
+    bool enabled() const;
+
+    /// Hand the sound side an event
+    void post(EventType type, int32_t value = 0);
+
+    /// Catch the Z80 up to the last slice boundary and wait for everything posted to be handled
+    void sync();
+
+    /// Wait for everything posted to be handled
+    void finish();
+
+private:
+    NeoGeoCD& machine;
+
+#ifdef HAVE_THREADS
+    void work();
+    void wakeThread();
+    bool idle() const;
+
+    // A few frames' worth of slice boundaries; a full queue waits for the thread
+    static constexpr uint32_t QUEUE_SIZE = 4096;
+
+    // Boundaries are handed over without waking the thread until this many cycles of them are waiting
+    static constexpr int32_t WAKE_CYCLES = Timer::CYCLES_PER_FRAME / 32;
+
+    // Times either side yields, looking for the other to be done, before it sleeps on it
+    static constexpr uint32_t SPIN_COUNT = 64;
+
+    std::thread              thread;
+    Event                    queue[QUEUE_SIZE];
+    std::atomic<uint32_t>    queueHead{ 0 };
+    std::atomic<uint32_t>    queueTail{ 0 };
+    std::atomic<bool>        sleeping{ false };
+    int32_t                  unwokenCycles = 0;
+    std::mutex               mutex;
+    std::condition_variable  wake;
+    std::condition_variable  drained;
+    bool                     woken = false;
+    bool                     stopping = false;
+#endif
+};
+
+#endif // SOUND_THREAD_H
@@ -2,7 +2,6 @@
 #include <limits>
 
 #include "3rdparty/ym/ym2610.h"
-#include "3rdparty/z80/z80.h"
 #include "libretro_common.h"
 #include "libretro_log.h"
 #include "neogeocd.h"
@@ -37,6 +36,7 @@ void vblIrqTimerCallback(Timer* timer, uint32_t userData)
     {
         neocd->video.autoAnimationFrameCounter = neocd->video.autoAnimationSpeed;
         neocd->video.autoAnimationCounter++;
+        neocd->video.pictureChanged();
     }
     else
         neocd->video.autoAnimationFrameCounter--;
@@ -126,13 +126,7 @@ void drawlineTimerCallback(Timer* timer, uint32_t userData)
         if ((scanline >= Timer::ACTIVE_AREA_TOP) && (scanline < Timer::ACTIVE_AREA_BOTTOM))
         {
             if (neocd->video.videoEnable)
-            {
-                if (!builtAhead[scanline & 1])
-                    neocd->video.drawEmptyLine(scanline);
-
-                if (!neocd->video.fixDisable)
-                    neocd->video.drawFix(scanline);
-            }
+                neocd->video.showLine(scanline, builtAhead[scanline & 1]);
             else
                 neocd->video.drawBlackLine(scanline);
         }
@@ -144,13 +138,8 @@ void drawlineTimerCallback(Timer* timer, uint32_t userData)
         {
             if (neocd->video.videoEnable)
             {
-                neocd->video.drawEmptyLine(renderLine);
-
-                if (!neocd->video.sprDisable)
-                {
-                    const size_t address = (renderLine & 1) ? 0x8680 : 0x8600;
-                    neocd->video.renderScanlineSprites(renderLine, &neocd->memory.videoRam[address]);
-                }
+                const size_t address = (renderLine & 1) ? 0x8680 : 0x8600;
+                neocd->video.buildLine(renderLine, neocd->video.sprDisable ? nullptr : &neocd->memory.videoRam[address]);
 
                 builtAhead[renderLine & 1] = true;
             }
@@ -217,16 +206,7 @@ void cdromTimerCallback(Timer* timer, uint32_t userData)
 
 void audioCommandTimerCallback(Timer* timer, uint32_t userData)
 {
-    // Post the audio command to the Z80
-    neocd->audioCommand = userData;
-
-    // If the NMI is not disabled
-    if (!neocd->z80NMIDisable)
-    {
-        // Trigger it
-        z80_set_irq_line(INPUT_LINE_NMI, ASSERT_LINE);
-        z80_set_irq_line(INPUT_LINE_NMI, CLEAR_LINE);
-    }
+    neocd->sendAudioCommand(userData);
 }
 
 TimerGroup::TimerGroup() :
@@ -287,10 +267,13 @@ int32_t TimerGroup::timeSlice() const
 {
     int32_t timeSlice = round<int32_t>(Timer::MASTER_CLOCK / Timer::FRAME_RATE);
 
-    for(const Timer& timer : m_timers)
+    for(size_t i = 0; i < m_timers.size(); ++i)
     {
-        if (timer.isActive())
-            timeSlice = std::min(timeSlice, timer.delay());
+        if (onZ80Clock(i))
+            continue;
+
+        if (m_timers[i].isActive())
+            timeSlice = std::min(timeSlice, m_timers[i].delay());
     }
 
     return timeSlice;
@@ -298,8 +281,11 @@ int32_t TimerGroup::timeSlice() const
 
 void TimerGroup::advanceTime(const int32_t time)
 {
-    for(Timer& timer : m_timers)
-        timer.advanceTime(time);
+    for(size_t i = 0; i < m_timers.size(); ++i)
+    {
+        if (!onZ80Clock(i))
+            m_timers[i].advanceTime(time);
+    }
 }
 
 DataPacker& operator<<(DataPacker& out, const TimerGroup& timerGroup)
@@ -38,6 +38,12 @@ public:
 
     void advanceTime(const int32_t time);
 
+    /// The YM2610 timers are advanced by NeoGeoCD::runZ80 as the Z80 runs, not with the others
+    static inline bool onZ80Clock(size_t index)
+    {
+        return (index == Ym2610A) || (index == Ym2610B);
+    }
+
     template<size_t N>
     const Timer& timer() const
     {
@@ -2,12 +2,16 @@
 #include <algorithm>
 #include <array>
 
+#include <features/features_cpu.h>
+
 #include "inline.h"
 #include "libretro_common.h"
+#include "libretro_log.h"
 #include "neocd_endian.h"
 #include "neogeocd.h"
 #include "timer.h"
 #include "video.h"
+#include "video_blit.h"
 
 static const std::array<uint32_t, 256> SPR_DECODE_TABLE {
     0x00000000, 0x00000001, 0x00000010, 0x00000011,
@@ -76,28 +80,15 @@ static const std::array<uint32_t, 256> SPR_DECODE_TABLE {
     0x11111100, 0x11111101, 0x11111110, 0x11111111
 };
 
-static const std::array<uint8_t, 256> X_ZOOM_TABLE{
-    0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-    0, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-    0, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0,
-    0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 1, 0,
-    0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
-    1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0,
-    1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0,
-    1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0,
-    1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1,
-    1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1,
-    1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
-};
-
 Video::Video() :
-    paletteRamPc(nullptr),
+    fixOverlay(nullptr),
+    sprDecoded(nullptr),
+    sprOpaqueMask(nullptr),
+    sprTileDirty(nullptr),
+    workers(*this),
     fixUsageMap(nullptr),
+    lineBuffer(nullptr),
+    lineBufferStorage(nullptr),
     frameBuffer(nullptr),
     activePaletteBank(0),
     autoAnimationCounter(0),
@@ -121,34 +112,66 @@ Video::Video() :
     static_assert((FRAMEBUFFER_WIDTH % 16) == 0, "Framebuffer width must be a multiple of 16.");
     static_assert(FRAMEBUFFER_WIDTH <= 320, "Framebuffer width must less or equal to 320.");
 
-    // Palette RAM: 16KiB, converted into RGB565 equivalent
-    paletteRamPc = reinterpret_cast<uint16_t*>(std::malloc(Memory::PALETTERAM_SIZE));
-
     // Fix usage map, if zero tile is fully transparent
     fixUsageMap = reinterpret_cast<uint8_t*>(std::malloc(Memory::FIXRAM_SIZE / 32));
 
-    // 304x224 RGB565 framebuffer
-    frameBuffer = reinterpret_cast<uint16_t*>(std::malloc(FRAMEBUFFER_WIDTH * FRAMEBUFFER_HEIGHT * sizeof(uint16_t)));
+    // The fix layer as indices, a line of it per visible line
+    fixOverlay = reinterpret_cast<uint16_t*>(std::calloc(FRAMEBUFFER_WIDTH * FRAMEBUFFER_HEIGHT, sizeof(uint16_t)));
+    invalidateFixLayer();
+
+    // 320x224 palette indices, inside a guard band on either side of every line
+    lineBufferStorage = reinterpret_cast<uint16_t*>(std::calloc(LINEBUFFER_PITCH * FRAMEBUFFER_HEIGHT, sizeof(uint16_t)));
+    lineBuffer = lineBufferStorage + LINEBUFFER_GUARD;
+
+    // 320x224 finished pixels, room for the widest format
+    frameBuffer = std::calloc(FRAMEBUFFER_WIDTH * FRAMEBUFFER_HEIGHT, sizeof(uint32_t));
+
+    // Decoded sprite tiles: two words and a mask for each of the sixteen rows of every tile
+    sprDecoded = reinterpret_cast<uint32_t*>(std::malloc(SPRITE_TILE_COUNT * 16 * 2 * sizeof(uint32_t)));
+    sprOpaqueMask = reinterpret_cast<uint16_t*>(std::malloc(SPRITE_TILE_COUNT * 16 * sizeof(uint16_t)));
+    sprTileDirty = reinterpret_cast<uint8_t*>(std::malloc(SPRITE_TILE_COUNT));
+
+    invalidateSpriteCache();
+
+    // The row kernels are picked once, from what this processor can do
+    const char* kernels = VideoBlit::select(cpu_features_get());
+    Libretro::Log::message(RETRO_LOG_DEBUG, "Video: using %s row kernels.\n", kernels);
 }
 
 Video::~Video()
 {
+    // Nothing may still be drawing into what is about to go
+    workers.resize(0);
+
+    if (sprTileDirty)
+        std::free(sprTileDirty);
+
+    if (sprOpaqueMask)
+        std::free(sprOpaqueMask);
+
+    if (sprDecoded)
+        std::free(sprDecoded);
+
     if (frameBuffer)
         std::free(frameBuffer);
 
+    if (lineBufferStorage)
+        std::free(lineBufferStorage);
+
+    if (fixOverlay)
+        std::free(fixOverlay);
+
     if (fixUsageMap)
         std::free(fixUsageMap);
-
-    if (paletteRamPc)
-        std::free(paletteRamPc);
 }
 
 void Video::reset()
 {
     spriteIndexDirty = true;
+    invalidateSpriteCache();
 
-    std::memset(paletteRamPc, 0, Memory::PALETTERAM_SIZE);
     std::memset(fixUsageMap, 0, Memory::FIXRAM_SIZE / 32);
+    invalidateFixLayer();
     activePaletteBank = 0;
     autoAnimationCounter = 0;
     autoAnimationFrameCounter = 0;
@@ -169,113 +192,300 @@ void Video::reset()
     sprite_clipping = 0x20;
 }
 
-void Video::convertColor(uint32_t index)
+void Video::updateFixUsageMap()
 {
-    uint16_t c = BIG_ENDIAN_WORD(neocd->memory.paletteRam[index]);
+    const uint8_t* fixPtr = neocd->memory.fixRam;
 
-#ifdef ABGR1555
-    uint16_t out = ((c & 0x000F) << 11) | ((c & 0x1000) >> 2) |
-	(((c & 0x00F0) << 2) | ((c & 0x2000) >> 8)) |
-	(((c & 0x0F00) >> 7) | ((c & 0x4000) >> 14));
+    for (uint32_t character = 0; character < (Memory::FIXRAM_SIZE / 32); ++character, fixPtr += 32)
+    {
+        const uint8_t used = std::any_of(fixPtr, fixPtr + 32, [](const uint8_t& value) {
+            return value ? 1 : 0;
+        }) ? 1 : 0;
+
+        // A character that starts or stops drawing changes the rows showing it
+        if (fixUsageMap[character] != used)
+        {
+            fixUsageMap[character] = used;
+            fixCharacterChanged(character);
+        }
+    }
+}
 
-    // Five bit channels have nowhere to put the dark bit's half step.
-    if (shadow)
-        out = (out >> 1) & 0x3DEF;
+void Video::invalidateFixLayer()
+{
+    pictureMemoryWrite();
+    fixRowsDirty = FIX_ALL_ROWS;
+    std::memset(fixCharacterRows, 0, sizeof(fixCharacterRows));
+}
 
-    paletteRamPc[index] = out;
-#else
-    /* Each channel is really six bits on the machine: five from the
-       palette word plus the dark bit, inverted, as the low bit shared
-       by all three - read out of Geolith's converter. Green is the one
-       channel with six bits here, so it carries the dark bit exactly;
-       red and blue have nowhere to put a half step and keep their five.
-    */
-    uint16_t out = ((c & 0x0F00) << 4) | ((c & 0x4000) >> 3) |
-        ((c & 0x00F0) << 3) | ((c & 0x2000) >> 7) |
-        ((c & 0x000F) << 1) | ((c & 0x1000) >> 12);
+void Video::invalidateSpriteTiles(uint32_t offset, uint32_t length)
+{
+    if (!length)
+        return;
 
-    if (!(c & 0x8000))
-        out |= 0x0020;
+    // Sprite RAM is a ring, so a range that runs off the end carries on at the front
+    uint32_t first = offset / 128;
+    uint32_t last = (offset + length - 1) / 128;
 
-    /* The shadow register hangs a pulldown on every channel and the
-       screen comes out at about half brightness; halving each channel
-       is the same approximation Geolith's plain converter uses.
-    */
-    if (shadow)
-        out = (out >> 1) & 0x7BEF;
+    if ((last - first) >= SPRITE_TILE_COUNT)
+    {
+        invalidateSpriteCache();
+        return;
+    }
 
-    paletteRamPc[index] = out;
-#endif
+    for (uint32_t tile = first; tile <= last; ++tile)
+        invalidateSpriteTile(tile);
 }
 
-void Video::convertPalette()
+void Video::invalidateSpriteCache()
 {
-    for (uint32_t i = 0; i < (Memory::PALETTERAM_SIZE / sizeof(uint16_t)); ++i)
-        convertColor(i);
+    pictureMemoryWrite();
+    std::memset(sprTileDirty, 1, SPRITE_TILE_COUNT);
+    sprTilesDirty = true;
 }
 
-void Video::updateFixUsageMap()
+void Video::decodeSpriteTiles()
 {
-    uint8_t* fixPtr = neocd->memory.fixRam;
-    uint8_t* usagePtrStart = fixUsageMap;
-    uint8_t* usagePtrEnd = fixUsageMap + (Memory::FIXRAM_SIZE / 32);
+    for (uint32_t tile = 0; tile < SPRITE_TILE_COUNT; ++tile)
+    {
+        if (sprTileDirty[tile])
+            decodeSpriteTile(tile);
+    }
 
-    std::generate(usagePtrStart, usagePtrEnd, [&]() {
-        bool result = std::any_of(fixPtr, fixPtr + 32, [](const uint8_t& value) {
-            return value ? 1 : 0;
-        });
+    sprTilesDirty = false;
+}
+
+void Video::decodeSpriteTile(uint32_t tile)
+{
+    const uint8_t* spriteBase = &neocd->memory.sprRam[tile * 128];
+    uint32_t* decoded = &sprDecoded[tile * 16 * 2];
+    uint16_t* opaque = &sprOpaqueMask[tile * 16];
+
+    /* Each row is eight bytes: the planes of its right half at the
+       start of the tile and those of its left half sixty four bytes
+       on. A pixel is opaque when any of its four plane bits is set, so
+       the mask is just the planes or'ed together.
+    */
+    for (uint32_t row = 0; row < 16; ++row)
+    {
+        const uint8_t* left = spriteBase + 64 + (row * 4);
+        const uint8_t* right = spriteBase + (row * 4);
 
-        fixPtr += 32;
-        return result;
-    });
+        decoded[row * 2] = SPR_DECODE_TABLE[left[1]]
+            | (SPR_DECODE_TABLE[left[0]] << 1)
+            | (SPR_DECODE_TABLE[left[3]] << 2)
+            | (SPR_DECODE_TABLE[left[2]] << 3);
+
+        decoded[row * 2 + 1] = SPR_DECODE_TABLE[right[1]]
+            | (SPR_DECODE_TABLE[right[0]] << 1)
+            | (SPR_DECODE_TABLE[right[3]] << 2)
+            | (SPR_DECODE_TABLE[right[2]] << 3);
+
+        opaque[row] = static_cast<uint16_t>((left[0] | left[1] | left[2] | left[3])
+            | ((right[0] | right[1] | right[2] | right[3]) << 8));
+    }
+
+    sprTileDirty[tile] = 0;
 }
 
-// Note: scanline between 16 and 240!
-void Video::drawFix(uint32_t scanline)
+static inline bool isSpriteOnScanline(uint32_t scanline, uint32_t y, uint32_t clipping)
 {
-    uint16_t* videoRamPtr = &neocd->memory.videoRam[(0xE004 / 2) + ((scanline - 16) / 8)] + (Video::LEFT_BORDER * 4);
-    uint16_t* videoRamEndPtr = videoRamPtr + (FRAMEBUFFER_WIDTH * 4);
-    uint16_t* frameBufferPtr = frameBuffer + ((scanline - 16) * FRAMEBUFFER_WIDTH);
+    return (clipping == 0) || (clipping >= 0x20) || ((scanline - y) & 0x1ff) < (clipping * 0x10);
+}
 
-    for (; videoRamPtr < videoRamEndPtr; videoRamPtr += 32)
+namespace
+{
+    /// The lines a sprite covers: at most two runs, because its height can wrap past the bottom of the nine bit space
+    struct SpriteCoverage
     {
-        int character = (*videoRamPtr) & 0x0FFF;
-        int palette = ((*videoRamPtr) & 0xF000) >> 12;
+        uint8_t count = 0;
+        uint8_t from[2];
+        uint8_t to[2];
 
-        // Check for total transparency, no need to draw
-        if (!fixUsageMap[character])
+        bool operator==(const SpriteCoverage& other) const
         {
-            frameBufferPtr += 8;
-            continue;
-        }
+            if (count != other.count)
+                return false;
 
-        uint8_t* fixBase = &neocd->memory.fixRam[(character * 32) + (scanline % 8)];
-        uint16_t* paletteBase = &paletteRamPc[(activePaletteBank * 4096) + (palette * 16)];
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if ((from[i] != other.from[i]) || (to[i] != other.to[i]))
+                    return false;
+            }
 
-        auto decodeAndDrawFix = [&](int n) ALWAYS_INLINE {
-            uint8_t pixelA = fixBase[n];
-            uint8_t pixelB = pixelA >> 4;
-            pixelA &= 0x0F;
+            return true;
+        }
+    };
 
-            if (pixelA)
-                *frameBufferPtr = paletteBase[pixelA];
-            frameBufferPtr++;
+    SpriteCoverage spriteCoverage(uint32_t y, uint32_t clipping)
+    {
+        SpriteCoverage coverage;
 
-            if (pixelB)
-                *frameBufferPtr = paletteBase[pixelB];
-            frameBufferPtr++;
+        auto take = [&](uint32_t from, uint32_t to) {
+            from = std::max<uint32_t>(from, Timer::ACTIVE_AREA_TOP);
+            to = std::min<uint32_t>(to, Timer::ACTIVE_AREA_BOTTOM);
+            if (from < to)
+            {
+                coverage.from[coverage.count] = static_cast<uint8_t>(from - Timer::ACTIVE_AREA_TOP);
+                coverage.to[coverage.count] = static_cast<uint8_t>(to - Timer::ACTIVE_AREA_TOP);
+                ++coverage.count;
+            }
         };
 
-        decodeAndDrawFix(16);
-        decodeAndDrawFix(24);
-        decodeAndDrawFix(0);
-        decodeAndDrawFix(8);
+        if (!clipping)
+            return coverage;
+
+        if (clipping >= 0x20)
+        {
+            take(Timer::ACTIVE_AREA_TOP, Timer::ACTIVE_AREA_BOTTOM);
+            return coverage;
+        }
+
+        // The covered lines: y to y + height, wrapped in the chip's
+        // nine bit space, clipped to the visible area.
+        uint32_t height = clipping * 0x10;
+        uint32_t end = (y + height) & 0x1FF;
+
+        if (y < end)
+            take(y, end);
+        else
+        {
+            take(y, 0x200);
+            take(0, end);
+        }
+
+        return coverage;
+    }
+
+    inline uint32_t lowestSetBit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint32_t>(__builtin_ctzll(value));
+#else
+        uint32_t bit = 0;
+        while (!(value & 1))
+        {
+            value >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    /* Which columns of the line being drawn front to back already hold
+       a sprite pixel, bit n for column n of the line including its
+       guard band. The guard columns start out covered: nothing drawn
+       there is ever seen, so a sprite is only worth drawing for what it
+       adds to the visible line.
+    */
+    constexpr uint32_t COVERED_WORDS = (Video::LINEBUFFER_PITCH + 63) / 64;
+
+    inline void uncoverLine(uint64_t* covered)
+    {
+        for (uint32_t word = 0; word < COVERED_WORDS; ++word)
+            covered[word] = 0;
+
+        for (uint32_t column = 0; column < Video::LINEBUFFER_GUARD; ++column)
+        {
+            const uint32_t right = Video::LINEBUFFER_PITCH - 1 - column;
+            covered[column / 64] |= uint64_t(1) << (column & 63);
+            covered[right / 64] |= uint64_t(1) << (right & 63);
+        }
+    }
+
+    inline bool lineCovered(const uint64_t* covered)
+    {
+        uint64_t all = ~uint64_t(0);
+
+        for (uint32_t word = 0; word < COVERED_WORDS - 1; ++word)
+            all &= covered[word];
+
+        const uint32_t lastBits = Video::LINEBUFFER_PITCH - ((COVERED_WORDS - 1) * 64);
+        const uint64_t lastMask = (lastBits >= 64) ? ~uint64_t(0) : ((uint64_t(1) << lastBits) - 1);
+
+        return (all == ~uint64_t(0)) && ((covered[COVERED_WORDS - 1] & lastMask) == lastMask);
+    }
+
+    // Sixteen columns from column on, a sprite line's worth
+    inline uint32_t coveredSpan(const uint64_t* covered, uint32_t column)
+    {
+        const uint32_t shift = column & 63;
+        uint64_t bits = covered[column / 64] >> shift;
+
+        if (shift > 48)
+            bits |= covered[(column / 64) + 1] << (64 - shift);
+
+        return static_cast<uint32_t>(bits & 0xFFFF);
+    }
+
+    inline void coverSpan(uint64_t* covered, uint32_t column, uint32_t columns)
+    {
+        const uint32_t shift = column & 63;
+        covered[column / 64] |= uint64_t(columns) << shift;
+
+        if (shift > 48)
+            covered[(column / 64) + 1] |= uint64_t(columns) >> (64 - shift);
+    }
+} // namespace
+
+void Video::resolveSprite(uint32_t spriteNumber, SpriteChain& chain) const
+{
+    uint32_t attributes1 = neocd->memory.videoRam[0x8000 + spriteNumber];
+    uint32_t attributes2 = neocd->memory.videoRam[0x8200 + spriteNumber];
+
+    if (attributes2 & 0x40)
+    {
+        chain.x = (chain.x + chain.zoomX + 1) & 0x1FF;
+        chain.zoomX = (attributes1 >> 8) & 0xF;
+    }
+    else
+    {
+        chain.zoomY = attributes1 & 0xFF;
+        chain.zoomX = (attributes1 >> 8) & 0xF;
+        chain.clipping = attributes2 & 0x3F;
+        chain.y = 0x200 - (attributes2 >> 7);
+        chain.x = neocd->memory.videoRam[0x8400 + spriteNumber] >> 7;
     }
 }
 
-static inline bool isSpriteOnScanline(uint32_t scanline, uint32_t y, uint32_t clipping)
+void Video::setSpriteMembership(uint32_t spriteNumber, bool member)
 {
-    return (clipping == 0) || (clipping >= 0x20) || ((scanline - y) & 0x1ff) < (clipping * 0x10);
+    const SpriteCoverage coverage = spriteCoverage(resolvedY[spriteNumber], resolvedClipping[spriteNumber]);
+    const uint64_t bit = 1ull << (spriteNumber & 63);
+    const uint32_t word = spriteNumber >> 6;
+
+    for (uint32_t run = 0; run < coverage.count; ++run)
+    {
+        for (uint32_t row = coverage.from[run]; row < coverage.to[run]; ++row)
+        {
+            if (member)
+                lineMembers[row][word] |= bit;
+            else
+                lineMembers[row][word] &= ~bit;
+
+            lineListDirty[row] = 1;
+        }
+    }
+}
+
+void Video::rebuildLineList(uint32_t row)
+{
+    uint8_t count = 0;
+
+    // Bank order, stopping at the chip's ninety six as the chip's own scan stops
+    for (uint32_t word = 0; (word < SPRITE_MEMBER_WORDS) && (count < MAX_SPRITES_PER_LINE); ++word)
+    {
+        uint64_t bits = lineMembers[row][word];
+
+        while (bits && (count < MAX_SPRITES_PER_LINE))
+        {
+            lineSprites[row][count++] = static_cast<uint16_t>((word * 64) + lowestSetBit(bits));
+            bits &= bits - 1;
+        }
+    }
+
+    lineSpriteCount[row] = count;
+    lineListDirty[row] = 0;
 }
 
 void Video::rebuildSpriteIndex()
@@ -288,113 +498,118 @@ void Video::rebuildSpriteIndex()
        it, in bank order, stopping at the chip's ninety six as the
        chip's own scan stops.
     */
-    const uint16_t* scb3 = &neocd->memory.videoRam[0x8000];
-    const uint16_t* scb2 = &neocd->memory.videoRam[0x8200];
-    const uint16_t* scb4 = &neocd->memory.videoRam[0x8400];
+    SpriteChain chain;
 
-    uint32_t x = 0;
-    uint32_t y = 0;
-    uint32_t zoomX = 0xF;
-    uint32_t zoomY = 0xFF;
-    uint32_t clipping = 0;
+    std::memset(lineMembers, 0, sizeof(lineMembers));
 
     for (uint16_t spriteNumber = 1; spriteNumber <= MAX_SPRITES_PER_SCREEN; ++spriteNumber)
     {
-        uint32_t attributes1 = scb3[spriteNumber];
-        uint32_t attributes2 = scb2[spriteNumber];
+        resolveSprite(spriteNumber, chain);
 
-        if (attributes2 & 0x40)
-        {
-            x = (x + zoomX + 1) & 0x1FF;
-            zoomX = (attributes1 >> 8) & 0xF;
-        }
-        else
-        {
-            zoomY = attributes1 & 0xFF;
-            zoomX = (attributes1 >> 8) & 0xF;
-            clipping = attributes2 & 0x3F;
-            y = 0x200 - (attributes2 >> 7);
-            x = scb4[spriteNumber] >> 7;
-        }
+        resolvedX[spriteNumber] = static_cast<uint16_t>(chain.x);
+        resolvedY[spriteNumber] = static_cast<uint16_t>(chain.y);
+        resolvedZoomX[spriteNumber] = static_cast<uint8_t>(chain.zoomX);
+        resolvedZoomY[spriteNumber] = static_cast<uint8_t>(chain.zoomY);
+        resolvedClipping[spriteNumber] = static_cast<uint8_t>(chain.clipping);
 
-        resolvedX[spriteNumber] = static_cast<uint16_t>(x);
-        resolvedY[spriteNumber] = static_cast<uint16_t>(y);
-        resolvedZoomX[spriteNumber] = static_cast<uint8_t>(zoomX);
-        resolvedZoomY[spriteNumber] = static_cast<uint8_t>(zoomY);
-        resolvedClipping[spriteNumber] = static_cast<uint8_t>(clipping);
+        setSpriteMembership(spriteNumber, true);
     }
 
-    std::memset(lineSpriteCount, 0, sizeof(lineSpriteCount));
+    for (uint32_t row = 0; row < FRAMEBUFFER_HEIGHT; ++row)
+        rebuildLineList(row);
 
-    for (uint16_t spriteNumber = 1; spriteNumber <= MAX_SPRITES_PER_SCREEN; ++spriteNumber)
+    spriteIndexDirty = false;
+    firstChangedSprite = MAX_SPRITES_PER_SCREEN + 1;
+    lastChangedSprite = 0;
+    ++spriteIndexStats.rebuilds;
+}
+
+void Video::updateSpriteIndex()
+{
+    /* Only the sprites from the first one written to onwards can have
+       moved, and only as far as the chain carries a change: past the
+       last sprite written, the first one that resolves to what it was
+       before leaves every one after it where it was too. A sprite
+       that moves without changing the lines it covers leaves every
+       line's list alone; only the lines it joins or leaves are listed
+       again.
+    */
+    SpriteChain chain;
+
+    if (firstChangedSprite > 1)
     {
-        uint32_t c = resolvedClipping[spriteNumber];
+        const uint32_t previous = firstChangedSprite - 1;
+        chain.x = resolvedX[previous];
+        chain.y = resolvedY[previous];
+        chain.zoomX = resolvedZoomX[previous];
+        chain.zoomY = resolvedZoomY[previous];
+        chain.clipping = resolvedClipping[previous];
+    }
 
-        if (!c)
-            continue;
+    for (uint32_t spriteNumber = firstChangedSprite; spriteNumber <= MAX_SPRITES_PER_SCREEN; ++spriteNumber)
+    {
+        resolveSprite(spriteNumber, chain);
 
-        auto take = [&](uint32_t from, uint32_t to) {
-            for (uint32_t line = from; line < to; ++line)
-            {
-                uint8_t& count = lineSpriteCount[line - Timer::ACTIVE_AREA_TOP];
-                if (count < MAX_SPRITES_PER_LINE)
-                    lineSprites[line - Timer::ACTIVE_AREA_TOP][count++] = spriteNumber;
-            }
-        };
+        const bool moved = (resolvedX[spriteNumber] != chain.x)
+            || (resolvedZoomX[spriteNumber] != chain.zoomX)
+            || (resolvedZoomY[spriteNumber] != chain.zoomY);
+        const bool resized = (resolvedY[spriteNumber] != chain.y)
+            || (resolvedClipping[spriteNumber] != chain.clipping);
 
-        if (c >= 0x20)
+        if (!moved && !resized)
         {
-            take(Timer::ACTIVE_AREA_TOP, Timer::ACTIVE_AREA_BOTTOM);
+            if (spriteNumber > lastChangedSprite)
+                break;
+
             continue;
         }
 
-        // The covered lines: y to y + height, wrapped in the chip's
-        // nine bit space, clipped to the visible area.
-        uint32_t sy = resolvedY[spriteNumber];
-        uint32_t height = c * 0x10;
-        uint32_t end = (sy + height) & 0x1FF;
+        const bool relisted = resized
+            && !(spriteCoverage(resolvedY[spriteNumber], resolvedClipping[spriteNumber]) == spriteCoverage(chain.y, chain.clipping));
 
-        auto clamp = [&](uint32_t from, uint32_t to) {
-            from = std::max<uint32_t>(from, Timer::ACTIVE_AREA_TOP);
-            to = std::min<uint32_t>(to, Timer::ACTIVE_AREA_BOTTOM);
-            if (from < to)
-                take(from, to);
-        };
+        if (relisted)
+            setSpriteMembership(spriteNumber, false);
 
-        if (sy < end)
-            clamp(sy, end);
-        else
+        resolvedX[spriteNumber] = static_cast<uint16_t>(chain.x);
+        resolvedY[spriteNumber] = static_cast<uint16_t>(chain.y);
+        resolvedZoomX[spriteNumber] = static_cast<uint8_t>(chain.zoomX);
+        resolvedZoomY[spriteNumber] = static_cast<uint8_t>(chain.zoomY);
+        resolvedClipping[spriteNumber] = static_cast<uint8_t>(chain.clipping);
+
+        if (relisted)
+            setSpriteMembership(spriteNumber, true);
+    }
+
+    uint32_t relistedLines = 0;
+
+    for (uint32_t row = 0; row < FRAMEBUFFER_HEIGHT; ++row)
+    {
+        if (lineListDirty[row])
         {
-            clamp(sy, 0x200);
-            clamp(0, end);
+            rebuildLineList(row);
+            ++relistedLines;
         }
     }
 
-    spriteIndexDirty = false;
+    firstChangedSprite = MAX_SPRITES_PER_SCREEN + 1;
+    lastChangedSprite = 0;
+    ++spriteIndexStats.updates;
+    spriteIndexStats.linesRelisted += relistedLines;
+    spriteIndexStats.linesAvoided += FRAMEBUFFER_HEIGHT - relistedLines;
 }
 
-uint16_t Video::renderScanlineSprites(uint32_t scanline, uint16_t *spriteList)
+uint16_t Video::listScanlineSprites(uint32_t scanline, uint16_t *spriteList)
 {
     if (spriteIndexDirty)
         rebuildSpriteIndex();
+    else if (firstChangedSprite <= lastChangedSprite)
+        updateSpriteIndex();
 
     const uint32_t row = scanline - Timer::ACTIVE_AREA_TOP;
     const uint16_t activeCount = lineSpriteCount[row];
 
-    for (uint16_t at = 0; at < activeCount; ++at)
-    {
-        uint16_t spriteNumber = lineSprites[row][at];
-
-        *spriteList++ = spriteNumber;
-
-        drawSprite(spriteNumber,
-                   resolvedX[spriteNumber],
-                   resolvedY[spriteNumber],
-                   resolvedZoomX[spriteNumber],
-                   resolvedZoomY[spriteNumber],
-                   scanline,
-                   resolvedClipping[spriteNumber]);
-    }
+    std::memcpy(spriteList, lineSprites[row], sizeof(uint16_t) * activeCount);
+    spriteList += activeCount;
 
     // Fill the rest of the sprite list with 0, including one extra entry
     std::memset(spriteList, 0, sizeof(uint16_t) * (MAX_SPRITES_PER_LINE - activeCount + 1));
@@ -402,260 +617,83 @@ uint16_t Video::renderScanlineSprites(uint32_t scanline, uint16_t *spriteList)
     return activeCount;
 }
 
-inline void drawSpriteLine(
-    uint32_t zoomX,
-    int increment,
-    uint32_t pixelData,
-    uint32_t pixelDataB,
-    const uint16_t* paletteBase,
-    uint16_t*& frameBufferPtr)
+void Video::drawScanlineSprites(uint32_t scanline, uint32_t autoAnimation)
 {
-    uint16_t* out = frameBufferPtr;
-
-    // Full width is nearly every sprite on screen; give it a straight
-    // sixteen pixel run with no per-pixel table looks.
-    if (zoomX == 15)
-    {
-        for (int i = 0; i < 8; ++i)
-        {
-            if (pixelData & (0xFu << (i * 4)))
-                *out = paletteBase[(pixelData >> (i * 4)) & 0xF];
-            out += increment;
-        }
-        for (int i = 0; i < 8; ++i)
-        {
-            if (pixelDataB & (0xFu << (i * 4)))
-                *out = paletteBase[(pixelDataB >> (i * 4)) & 0xF];
-            out += increment;
-        }
-        frameBufferPtr = out;
-        return;
-    }
-
-    auto drawSprLine = [&](int N) {
-        for(int i = 0; i < 8; ++i)
-        {
-            if (X_ZOOM_TABLE[N * 16 + i])
-            {
-                uint32_t mask = 0xF << (i * 4);
-                if (pixelData & mask)
-                    *out = paletteBase[(pixelData >> (i * 4)) & 0xF];
-                out += increment;
-            }
-        }
+    const uint32_t row = scanline - Timer::ACTIVE_AREA_TOP;
+    const uint16_t activeCount = lineSpriteCount[row];
+    const uint16_t* sprites = lineSprites[row];
 
-        for(int i = 0; i < 8; ++i)
-        {
-            if (X_ZOOM_TABLE[N * 16 + 8 + i])
-            {
-                uint32_t mask = 0xF << (i * 4);
-                if (pixelDataB & mask)
-                    *out = paletteBase[(pixelDataB >> (i * 4)) & 0xF];
-                out += increment;
-            }
-        }
+    auto draw = [&](uint16_t spriteNumber, uint64_t* covered) {
+        drawSprite(spriteNumber,
+                   resolvedX[spriteNumber],
+                   resolvedY[spriteNumber],
+                   resolvedZoomX[spriteNumber],
+                   resolvedZoomY[spriteNumber],
+                   scanline,
+                   resolvedClipping[spriteNumber],
+                   autoAnimation,
+                   covered);
     };
 
-    switch (zoomX)
-    {
-    case 0:
-        drawSprLine(0);
-        break;
-    case 1:
-        drawSprLine(1);
-        break;
-    case 2:
-        drawSprLine(2);
-        break;
-    case 3:
-        drawSprLine(3);
-        break;
-    case 4:
-        drawSprLine(4);
-        break;
-    case 5:
-        drawSprLine(5);
-        break;
-    case 6:
-        drawSprLine(6);
-        break;
-    case 7:
-        drawSprLine(7);
-        break;
-    case 8:
-        drawSprLine(8);
-        break;
-    case 9:
-        drawSprLine(9);
-        break;
-    case 10:
-        drawSprLine(10);
-        break;
-    case 11:
-        drawSprLine(11);
-        break;
-    case 12:
-        drawSprLine(12);
-        break;
-    case 13:
-        drawSprLine(13);
-        break;
-    case 14:
-        drawSprLine(14);
-        break;
-    case 15:
-        drawSprLine(15);
-        break;
-    }
-
-    frameBufferPtr = out;
-}
-
-inline void drawSpriteLineClipped(
-    uint32_t zoomX,
-    int increment,
-    uint32_t pixelData,
-    uint32_t pixelDataB,
-    const uint16_t* paletteBase,
-    uint16_t*& frameBufferPtr,
-    const uint16_t* low,
-    const uint16_t* high)
-{
-    uint16_t* out = frameBufferPtr;
-
-    // Full width is nearly every sprite on screen; a straight sixteen
-    // pixel run, still held inside the line like the general loop.
-    if (zoomX == 15)
-    {
-        for (int i = 0; i < 8; ++i)
-        {
-            if ((pixelData & (0xFu << (i * 4))) && (out >= low) && (out < high))
-                *out = paletteBase[(pixelData >> (i * 4)) & 0xF];
-            out += increment;
-        }
-        for (int i = 0; i < 8; ++i)
-        {
-            if ((pixelDataB & (0xFu << (i * 4))) && (out >= low) && (out < high))
-                *out = paletteBase[(pixelDataB >> (i * 4)) & 0xF];
-            out += increment;
-        }
-        frameBufferPtr = out;
-        return;
-    }
+    /* Later sprites in the list are drawn over earlier ones. Walking it
+       backwards, the first opaque pixel to land on a column is the one
+       that stays, so every pixel after it can be skipped, and once the
+       whole line is covered nothing behind it is looked at at all.
+    */
+    if (globals.spriteFrontToBack)
+    {
+        uint64_t covered[COVERED_WORDS];
+        uncoverLine(covered);
 
-    auto drawSprLine = [&](int N) {
-        for(int i = 0; i < 8; ++i)
+        for (uint16_t at = activeCount; at > 0; --at)
         {
-            if (X_ZOOM_TABLE[N * 16 + i])
-            {
-                uint32_t mask = 0xF << (i * 4);
-                if ((pixelData & mask) && (out >= low) && (out < high))
-                    *out = paletteBase[(pixelData >> (i * 4)) & 0xF];
-                out += increment;
-            }
-        }
+            draw(sprites[at - 1], covered);
 
-        for(int i = 0; i < 8; ++i)
-        {
-            if (X_ZOOM_TABLE[N * 16 + 8 + i])
-            {
-                uint32_t mask = 0xF << (i * 4);
-                if ((pixelDataB & mask) && (out >= low) && (out < high))
-                    *out = paletteBase[(pixelDataB >> (i * 4)) & 0xF];
-                out += increment;
-            }
+            if (lineCovered(covered))
+                break;
         }
-    };
+    }
+    else
+    {
+        for (uint16_t at = 0; at < activeCount; ++at)
+            draw(sprites[at], nullptr);
+    }
+}
 
-    switch (zoomX)
-    {
-    case 0:
-        drawSprLine(0);
-        break;
-    case 1:
-        drawSprLine(1);
-        break;
-    case 2:
-        drawSprLine(2);
-        break;
-    case 3:
-        drawSprLine(3);
-        break;
-    case 4:
-        drawSprLine(4);
-        break;
-    case 5:
-        drawSprLine(5);
-        break;
-    case 6:
-        drawSprLine(6);
-        break;
-    case 7:
-        drawSprLine(7);
-        break;
-    case 8:
-        drawSprLine(8);
-        break;
-    case 9:
-        drawSprLine(9);
-        break;
-    case 10:
-        drawSprLine(10);
-        break;
-    case 11:
-        drawSprLine(11);
-        break;
-    case 12:
-        drawSprLine(12);
-        break;
-    case 13:
-        drawSprLine(13);
-        break;
-    case 14:
-        drawSprLine(14);
-        break;
-    case 15:
-        drawSprLine(15);
-        break;
-    }
-
-    frameBufferPtr = out;
-}
-
-void Video::drawSprite(uint32_t spriteNumber, uint32_t x, uint32_t y, uint32_t zoomX, uint32_t zoomY, uint32_t scanline, uint32_t clipping)
+void Video::drawSprite(uint32_t spriteNumber, uint32_t x, uint32_t y, uint32_t zoomX, uint32_t zoomY, uint32_t scanline, uint32_t clipping, uint32_t autoAnimation, uint64_t* covered)
 {
     uint32_t spriteLine = (scanline - y) & 0x1FF;
     uint32_t zoomLine = spriteLine & 0xFF;
     bool invert = (spriteLine & 0x100) != 0;
 
-    enum Status {
-        Normal,
-        Clipped,
-        Invisible
-    };
+    // Where the sprite starts on the line, in the nine bit space
+    // wrapped so a sprite hanging off the left edge starts before it.
+    int32_t left = static_cast<int32_t>(x) - Video::LEFT_BORDER;
 
-    auto withinLimits = [&](uint32_t value) {
-        return (value >= Video::LEFT_BORDER) && (value <= Video::RIGHT_BORDER);
-    };
-
-    auto checkVisibility = [&]() -> Status
-    {
-        uint32_t x2 = (x + zoomX + 1) & 0x1FF;
-        uint32_t x1 = (x & 0x1FF);
-
-        if (!withinLimits(x1) && !withinLimits(x2))
-            return Invisible;
+    if (x > 0x1F0)
+        left -= 0x200;
 
-        if (!withinLimits(x1) || !withinLimits(x2))
-            return Clipped;
+    /* Off the line altogether? Anything that is even partly on it is
+       drawn whole: the framebuffer has a guard band either side wide
+       enough for the sixteen pixels of the widest sprite to land in,
+       so an edge sprite needs no clipping and goes through the same
+       kernel as any other.
+    */
+    if ((left >= static_cast<int32_t>(FRAMEBUFFER_WIDTH)) || ((left + static_cast<int32_t>(zoomX)) < 0))
+        return;
 
-        return Normal;
-    };
+    // Drawing front to back, only the columns nothing nearer has covered yet
+    const uint32_t column = static_cast<uint32_t>(left + static_cast<int32_t>(LINEBUFFER_GUARD));
+    const uint32_t span = (2u << zoomX) - 1;
+    uint32_t write = span;
 
-    Status spriteStatus = checkVisibility();
+    if (covered)
+    {
+        write &= ~coveredSpan(covered, column);
 
-    if (spriteStatus == Invisible)
-        return;
+        if (!write)
+            return;
+    }
 
     if (invert)
         zoomLine ^= 0xFF;
@@ -688,76 +726,300 @@ void Video::drawSprite(uint32_t spriteNumber, uint32_t x, uint32_t y, uint32_t z
         tileLine ^= 0x0F;
 
     // Auto animation
-    if (!autoAnimationDisabled)
+    if (autoAnimation != NO_AUTO_ANIMATION)
     {
         if (tileControl & 0x0008)
-            tileIndex = (tileIndex & ~0x07) | (autoAnimationCounter & 0x07);
+            tileIndex = (tileIndex & ~0x07) | (autoAnimation & 0x07);
         else if (tileControl & 0x0004)
-            tileIndex = (tileIndex & ~0x03) | (autoAnimationCounter & 0x03);
+            tileIndex = (tileIndex & ~0x03) | (autoAnimation & 0x03);
     }
 
-    const uint16_t* paletteBase = &paletteRamPc[(activePaletteBank * 0x1000) + ((tileControl >> 8) * 16)];
-    const uint8_t* spriteBase = &neocd->memory.sprRam[(tileIndex & 0x7FFF) * 128 + (tileLine * 4)];
+    const uint32_t tile = tileIndex & (SPRITE_TILE_COUNT - 1);
 
-    uint16_t* frameBufferPtr = frameBuffer;
+    if (sprTileDirty[tile])
+        decodeSpriteTile(tile);
 
-    frameBufferPtr += x;
+    const uint32_t tileRow = tile * 16 + tileLine;
+    const uint32_t opaque = sprOpaqueMask[tileRow];
 
-    if (x > 0x1F0)
-        frameBufferPtr -= 0x200;
+    // Nothing to draw on this row of the tile
+    if (!opaque)
+        return;
+
+    if (covered)
+        coverSpan(covered, column, VideoBlit::opaqueColumns(opaque, zoomX, tileControl & 1));
+
+    const uint32_t paletteBase = (tileControl >> 8) * 16;
+
+    uint16_t* lineBufferPtr = lineBuffer + ((scanline - 16) * LINEBUFFER_PITCH) + left;
 
-    frameBufferPtr -= Video::LEFT_BORDER;
+    // One kernel per zoom and flip, the full width ones being the
+    // vectorised ones where the processor has them.
+    VideoBlit::spriteLines[tileControl & 1][zoomX](
+        lineBufferPtr,
+        sprDecoded[tileRow * 2],
+        sprDecoded[tileRow * 2 + 1],
+        paletteBase,
+        write);
+}
+
+// Black whatever the palette says, so straight into the finished picture
+void Video::drawBlackLine(uint32_t scanline)
+{
+    const uint32_t row = scanline - 16;
+
+    recordLine(row);
+
+    if (shownGeneration[row] == LINE_BLACK)
+        return;
+
+    const uint32_t lineBytes = Video::FRAMEBUFFER_WIDTH * bytesPerPixel();
+    std::memset(static_cast<uint8_t*>(frameBuffer) + (row * lineBytes), 0, lineBytes);
+
+    shownGeneration[row] = LINE_BLACK;
+    frameChanged = true;
+}
+
+void Video::drawEmptyLine(uint32_t scanline)
+{
+    uint16_t* ptr = &lineBuffer[(scanline - 16) * Video::LINEBUFFER_PITCH];
+    uint16_t* ptrEnd = ptr + Video::FRAMEBUFFER_WIDTH;
 
-    frameBufferPtr += (scanline - 16) * FRAMEBUFFER_WIDTH;
+    // The backdrop is the last color of the bank
+    std::fill(ptr, ptrEnd, static_cast<uint16_t>(4095));
+}
 
-    int increment;
+void Video::resolveLine(uint32_t scanline, const uint16_t* indices)
+{
+    const uint32_t row = scanline - 16;
+    const uint32_t lineBytes = Video::FRAMEBUFFER_WIDTH * bytesPerPixel();
+
+    VideoBlit::resolveLines[pixelFormat](
+        static_cast<uint8_t*>(frameBuffer) + (row * lineBytes),
+        indices,
+        Video::FRAMEBUFFER_WIDTH,
+        &neocd->memory.paletteRam[lineJobs[row].paletteBank * 0x1000],
+        lineJobs[row].shadow);
+}
+
+void Video::redrawPicture()
+{
+    pictureChanged();
+    std::memset(shownGeneration, 0, sizeof(shownGeneration));
+}
+
+void Video::buildLine(uint32_t scanline, uint16_t* spriteList)
+{
+    const uint32_t row = scanline - 16;
 
-    if (tileControl & 1)
+    recordLine(row);
+
+    // The chip's list of the line's sprites is written out whether or not there is anything to draw
+    if (spriteList)
+        listScanlineSprites(scanline, spriteList);
+
+    if (builtGeneration[row] == pictureGeneration)
+        return;
+
+    LineJob& job = lineJobs[row];
+    job.steps |= LINE_BUILD | (spriteList ? LINE_SPRITES : 0);
+    job.autoAnimation = autoAnimationDisabled ? NO_AUTO_ANIMATION : static_cast<uint8_t>(autoAnimationCounter & 7);
+
+    builtGeneration[row] = pictureGeneration;
+
+    if (!workers.size())
+        renderLine(row);
+    else
+        linesPending = true;
+}
+
+void Video::showLine(uint32_t scanline, bool built)
+{
+    const uint32_t row = scanline - 16;
+
+    recordLine(row);
+
+    /* A line not built ahead shows the backdrop alone, which is not
+       what a build at any generation leaves in the line buffer. The
+       fix layer is blended into a copy of the line, leaving the line
+       buffer as built for the next time the line is shown.
+    */
+    if (built && (shownGeneration[row] == pictureGeneration) && (shownBuild[row] == builtGeneration[row]))
+        return;
+
+    LineJob& job = lineJobs[row];
+    job.steps |= LINE_SHOW;
+    job.paletteBank = static_cast<uint8_t>(activePaletteBank);
+    job.shadow = shadow;
+
+    if (!built)
     {
-        frameBufferPtr += zoomX;
-        increment = -1;
+        job.steps |= LINE_BACKDROP;
+        builtGeneration[row] = 0;
     }
-    else
-        increment = 1;
-
-    uint32_t pixelData = SPR_DECODE_TABLE[spriteBase[64 + 1]]
-        | (SPR_DECODE_TABLE[spriteBase[64 + 0]] << 1)
-        | (SPR_DECODE_TABLE[spriteBase[64 + 3]] << 2)
-        | (SPR_DECODE_TABLE[spriteBase[64 + 2]] << 3);
-
-    uint32_t pixelDataB = SPR_DECODE_TABLE[spriteBase[0 + 1]]
-        | (SPR_DECODE_TABLE[spriteBase[0 + 0]] << 1)
-        | (SPR_DECODE_TABLE[spriteBase[0 + 3]] << 2)
-        | (SPR_DECODE_TABLE[spriteBase[0 + 2]] << 3);
-
-    if (spriteStatus == Clipped)
-    {
-        drawSpriteLineClipped(
-            zoomX,
-            increment,
-            pixelData,
-            pixelDataB,
-            paletteBase,
-            frameBufferPtr,
-            frameBuffer + ((scanline - 16) * FRAMEBUFFER_WIDTH),
-            frameBuffer + ((scanline - 15) * FRAMEBUFFER_WIDTH));
+
+    if (!fixDisable)
+    {
+        // The fix layer is drawn here, never where lines are rendered
+        if (fixRowsDirty & (1u << (row / 8)))
+            drawFixRow(row / 8);
+
+        if (fixLineCells[row])
+            job.steps |= LINE_FIX;
     }
+
+    shownGeneration[row] = pictureGeneration;
+    shownBuild[row] = builtGeneration[row];
+    frameChanged = true;
+
+    if (!workers.size())
+        renderLine(row);
     else
-        drawSpriteLine(zoomX, increment, pixelData, pixelDataB, paletteBase, frameBufferPtr);
+    {
+        linesPending = true;
+
+        if ((row + 1 - firstUnposted >= LINES_PER_BAND) || (row == FRAMEBUFFER_HEIGHT - 1))
+        {
+            postLines(firstUnposted, row);
+            firstUnposted = row + 1;
+        }
+    }
 }
 
-void Video::drawBlackLine(uint32_t scanline)
+void Video::recordLine(uint32_t row)
 {
-    std::memset(&frameBuffer[(scanline - 16) * Video::FRAMEBUFFER_WIDTH], 0, Video::FRAMEBUFFER_WIDTH * sizeof(uint16_t));
+    // Back at the top: whatever of the last pass is still out has to be in before its lines are recorded again
+    if (row < firstUnposted)
+    {
+        finishLines();
+        firstUnposted = 0;
+    }
 }
 
-void Video::drawEmptyLine(uint32_t scanline)
+void Video::postLines(uint32_t first, uint32_t last)
 {
-    uint16_t* ptr = &frameBuffer[(scanline - 16) * Video::FRAMEBUFFER_WIDTH];
-    uint16_t* ptrEnd = ptr + Video::FRAMEBUFFER_WIDTH;
-    uint16_t color = paletteRamPc[(activePaletteBank * 0x1000) + 4095];
+    /* The render threads only read the decoded tiles and the sprite
+       index, so whatever is waiting to be done to them is done first.
+       Nothing in flight can be reading either while it is: changing
+       what they are derived from finishes the lines first.
+    */
+    if (sprTilesDirty)
+        decodeSpriteTiles();
+
+    if (spriteIndexDirty)
+        rebuildSpriteIndex();
+    else if (firstChangedSprite <= lastChangedSprite)
+        updateSpriteIndex();
+
+    workers.post(first, last);
+}
+
+void Video::finishLines()
+{
+    if (workers.size() && (firstUnposted < FRAMEBUFFER_HEIGHT))
+        postLines(firstUnposted, FRAMEBUFFER_HEIGHT - 1);
+
+    workers.finish();
+    linesPending = false;
+}
+
+void Video::renderLines(uint32_t first, uint32_t last)
+{
+    for (uint32_t row = first; row <= last; ++row)
+    {
+        if (lineJobs[row].steps)
+            renderLine(row);
+    }
+}
+
+void Video::renderLine(uint32_t row)
+{
+    LineJob& job = lineJobs[row];
+    const uint32_t scanline = row + 16;
+
+    if (job.steps & LINE_BUILD)
+    {
+        drawEmptyLine(scanline);
+
+        if (job.steps & LINE_SPRITES)
+            drawScanlineSprites(scanline, job.autoAnimation);
+    }
+
+    if (job.steps & LINE_SHOW)
+    {
+        if (job.steps & LINE_BACKDROP)
+            drawEmptyLine(scanline);
+
+        const uint16_t* indices = &lineBuffer[row * LINEBUFFER_PITCH];
+        uint16_t scratch[FRAMEBUFFER_WIDTH];
+
+        if (job.steps & LINE_FIX)
+        {
+            std::memcpy(scratch, indices, sizeof(scratch));
+            drawFix(scanline, scratch);
+            indices = scratch;
+        }
+
+        resolveLine(scanline, indices);
+    }
+
+    job.steps = 0;
+}
+
+// Note: scanline between 16 and 240!
+void Video::drawFix(uint32_t scanline, uint16_t* line)
+{
+    const uint32_t row = scanline - 16;
+    const uint16_t* overlayPtr = fixOverlay + (row * FRAMEBUFFER_WIDTH);
+
+    // Only the cells with something in them
+    for (uint64_t cells = fixLineCells[row]; cells; cells &= cells - 1)
+    {
+        const uint32_t cell = lowestSetBit(cells) * 8;
+        VideoBlit::fixBlend(line + cell, overlayPtr + cell);
+    }
+}
+
+void Video::drawFixRow(uint32_t row)
+{
+    const uint16_t* videoRamPtr = &neocd->memory.videoRam[(0xE004 / 2) + row] + (Video::LEFT_BORDER * 4);
+    uint16_t* overlayPtr = fixOverlay + (row * 8 * FRAMEBUFFER_WIDTH);
+    uint64_t* cells = &fixLineCells[row * 8];
+
+    std::fill(overlayPtr, overlayPtr + (8 * FRAMEBUFFER_WIDTH), static_cast<uint16_t>(0));
+    std::fill(cells, cells + 8, static_cast<uint64_t>(0));
+
+    for (uint32_t cell = 0; cell < (FRAMEBUFFER_WIDTH / 8); ++cell, videoRamPtr += 32)
+    {
+        const uint32_t character = (*videoRamPtr) & 0x0FFF;
+        const uint32_t paletteBase = ((*videoRamPtr) & 0xF000) >> 8;
+
+        fixCharacterRows[character] |= 1u << row;
+
+        // Check for total transparency, no need to draw
+        if (!fixUsageMap[character])
+            continue;
+
+        const uint8_t* fixBase = &neocd->memory.fixRam[character * 32];
+
+        for (uint32_t y = 0; y < 8; ++y, ++fixBase)
+        {
+            // Two pixels a byte, left one in the low nibble, and the four
+            // byte columns of a character stored third, fourth, first, second.
+            const uint32_t pixels = fixBase[16]
+                | (fixBase[24] << 8)
+                | (fixBase[0] << 16)
+                | (static_cast<uint32_t>(fixBase[8]) << 24);
+
+            if (pixels)
+            {
+                VideoBlit::fixRow(overlayPtr + (y * FRAMEBUFFER_WIDTH) + (cell * 8), pixels, paletteBase);
+                cells[y] |= uint64_t(1) << cell;
+            }
+        }
+    }
 
-    std::fill(ptr, ptrEnd, color);
+    fixRowsDirty &= ~(1u << row);
 }
 
 DataPacker& operator<<(DataPacker& out, const Video& video)
@@ -810,7 +1072,7 @@ DataPacker& operator>>(DataPacker& in, Video& video)
     // normal operation activePaletteBank is only ever 0 or 1, videoramOffset
     // is kept to 16 bits by the auto-increment mask, and sprite_zoomY is a
     // byte from the sprite attributes. A corrupt state could set any of them
-    // out of range, which would index paletteRam/paletteRamPc, videoRam and
+    // out of range, which would index paletteRam, videoRam and
     // yZoomRom out of bounds (and make (zoomY + 1) << 1 wrap to a zero
     // modulus). Fold them back into their hardware ranges here.
     video.activePaletteBank &= 1;
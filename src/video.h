@@ -2,6 +2,8 @@
 #define VIDEO_H
 
 #include "datapacker.h"
+#include "video_blit.h"
+#include "video_workers.h"
 
 #include <cstdint>
 
@@ -14,9 +16,17 @@ public:
     static constexpr uint16_t MAX_SPRITES_PER_SCREEN = 381;
     static constexpr uint16_t MAX_SPRITES_PER_LINE = 96;
 
-    // Used to clip sprites
+    // Where the framebuffer starts in sprite and fix coordinates
     static constexpr uint32_t LEFT_BORDER = 160 - (FRAMEBUFFER_WIDTH / 2);
-    static constexpr uint32_t RIGHT_BORDER = (FRAMEBUFFER_WIDTH / 2) + 159;
+
+    /* Every line buffer has this many pixels of slack before and after
+       it, never resolved: a sprite can start up to fifteen pixels before
+       the visible line and end fifteen after it, and drawing it whole
+       into the margin is cheaper than clipping it. LINEBUFFER_PITCH is
+       the distance between lines.
+    */
+    static constexpr uint32_t LINEBUFFER_GUARD = 16 + LEFT_BORDER;
+    static constexpr uint32_t LINEBUFFER_PITCH = FRAMEBUFFER_WIDTH + (LINEBUFFER_GUARD * 2);
 
     enum HirqControl
     {
@@ -38,15 +48,53 @@ public:
 
     void reset();
 
-    void convertColor(uint32_t index);
-    void convertPalette();
-
     void updateFixUsageMap();
 
-    void drawFix(uint32_t scanline);
+    void drawFix(uint32_t scanline, uint16_t* line);
+    void drawFixRow(uint32_t row);
+
+    /* The fix layer as last drawn, kept from line to line and frame to
+       frame: the 40x28 characters on screen as palette indices, zero
+       where transparent, and for every line a mask of which of its
+       eight pixel cells draw anything. A row of characters is drawn
+       again only when a line shows it after something it was drawn
+       from changed - one of its map words, or the data or usage of a
+       character it shows - so everything that writes those has to say
+       so here. Derived, never saved.
+    */
+    static constexpr uint32_t FIX_ROWS = FRAMEBUFFER_HEIGHT / 8;
+    static constexpr uint32_t FIX_ALL_ROWS = (1u << FIX_ROWS) - 1;
+    static constexpr uint32_t FIX_CHARACTER_COUNT = 0x1000;
+
+    inline void fixMapChanged(uint32_t offset)
+    {
+        // The map is 32 words to a column, the first visible row at word 2
+        const uint32_t row = (offset & 31) - 2;
+
+        pictureMemoryWrite();
 
-    uint16_t renderScanlineSprites(uint32_t scanline, uint16_t *spriteList);
+        if (row < FIX_ROWS)
+            fixRowsDirty |= 1u << row;
+    }
+
+    inline void fixCharacterChanged(uint32_t character)
+    {
+        pictureMemoryWrite();
+        fixRowsDirty |= fixCharacterRows[character & (FIX_CHARACTER_COUNT - 1)];
+    }
+
+    void invalidateFixLayer();
+
+    uint16_t* fixOverlay;
+    uint64_t  fixLineCells[FRAMEBUFFER_HEIGHT];
+    /// Rows each character has been drawn on since the whole layer was last drawn, bit n for row n
+    uint32_t  fixCharacterRows[FIX_CHARACTER_COUNT];
+    uint32_t  fixRowsDirty = FIX_ALL_ROWS;
+
+    uint16_t listScanlineSprites(uint32_t scanline, uint16_t *spriteList);
+    void drawScanlineSprites(uint32_t scanline, uint32_t autoAnimation);
     void rebuildSpriteIndex();
+    void updateSpriteIndex();
 
     /* Which sprites can touch which line, worked out once and reused
        until the sprite attributes change. Everything in the resolved
@@ -55,31 +103,215 @@ public:
        each line takes its own list, in bank order, capped at the
        chip's per line limit. Derived from video RAM, rebuilt on load,
        never saved.
+
+       A write to the attributes only marks the sprite: the next line
+       drawn resolves again from the first sprite marked, as far as the
+       change carries down the chain, and lists again only the lines a
+       sprite joined or left. spriteIndexDirty asks for the whole walk.
     */
+    struct SpriteChain
+    {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t zoomX = 0xF;
+        uint32_t zoomY = 0xFF;
+        uint32_t clipping = 0;
+    };
+
+    struct SpriteIndexStats
+    {
+        uint64_t rebuilds = 0;
+        uint64_t updates = 0;
+        uint64_t linesRelisted = 0;
+        uint64_t linesAvoided = 0;
+    };
+
+    static constexpr uint32_t SPRITE_MEMBER_WORDS = (MAX_SPRITES_PER_SCREEN + 64) / 64;
+
+    inline void spriteAttributesChanged(uint32_t spriteNumber)
+    {
+        if ((spriteNumber == 0) || (spriteNumber > MAX_SPRITES_PER_SCREEN))
+            return;
+
+        if (spriteNumber < firstChangedSprite)
+            firstChangedSprite = spriteNumber;
+
+        if (spriteNumber > lastChangedSprite)
+            lastChangedSprite = spriteNumber;
+    }
+
+    void resolveSprite(uint32_t spriteNumber, SpriteChain& chain) const;
+    void setSpriteMembership(uint32_t spriteNumber, bool member);
+    void rebuildLineList(uint32_t row);
+
     bool     spriteIndexDirty = true;
+    uint32_t firstChangedSprite = MAX_SPRITES_PER_SCREEN + 1;
+    uint32_t lastChangedSprite = 0;
     uint16_t resolvedX[MAX_SPRITES_PER_SCREEN + 1];
     uint16_t resolvedY[MAX_SPRITES_PER_SCREEN + 1];
     uint8_t  resolvedZoomX[MAX_SPRITES_PER_SCREEN + 1];
     uint8_t  resolvedZoomY[MAX_SPRITES_PER_SCREEN + 1];
     uint8_t  resolvedClipping[MAX_SPRITES_PER_SCREEN + 1];
+    uint64_t lineMembers[224][SPRITE_MEMBER_WORDS];
+    uint8_t  lineListDirty[224];
     uint16_t lineSprites[224][MAX_SPRITES_PER_LINE];
     uint8_t  lineSpriteCount[224];
+    SpriteIndexStats spriteIndexStats;
+
+    /* Sprite tiles as the drawing wants them, rather than as four
+       bitplanes: each of the sixteen rows of a tile is two words of
+       packed pixels, eight nibbles each, left half first, with a mask
+       of which of its pixels are opaque alongside, so a row with a
+       clear mask is known to draw nothing without looking at it. A
+       tile is decoded the first time it is drawn after a write touched
+       it, so everything that writes sprite RAM has to say so here.
+       Derived from sprite RAM, never saved.
+    */
+    static constexpr uint32_t SPRITE_TILE_COUNT = 0x8000;
+    uint32_t* sprDecoded;
+    uint16_t* sprOpaqueMask;
+    uint8_t*  sprTileDirty;
+
+    inline void invalidateSpriteTile(uint32_t tile)
+    {
+        pictureMemoryWrite();
+        sprTileDirty[tile & (SPRITE_TILE_COUNT - 1)] = 1;
+        sprTilesDirty = true;
+    }
+
+    void invalidateSpriteTiles(uint32_t offset, uint32_t length);
+    void invalidateSpriteCache();
+    void decodeSpriteTile(uint32_t tile);
+    void decodeSpriteTiles();
+
+    /// Whether any tile may be marked for decoding
+    bool sprTilesDirty = true;
+
     void drawSprite(uint32_t spriteNumber,
                     uint32_t x,
                     uint32_t y,
                     uint32_t zoomX,
                     uint32_t zoomY,
                     uint32_t scanline,
-                    uint32_t clipping);
+                    uint32_t clipping,
+                    uint32_t autoAnimation,
+                    uint64_t* covered);
     void drawBlackLine(uint32_t scanline);
     void drawEmptyLine(uint32_t scanline);
+    void resolveLine(uint32_t scanline, const uint16_t* indices);
+
+    /* Whether a line needs drawing again at all. Everything a line is
+       made from - video and palette RAM, sprite and fix data, the
+       switches and layer enables, the animation counter - calls
+       pictureChanged() when it changes. A line built or shown at the
+       same generation as the last time it was comes out the same, so
+       it is left as it is, and a frame in which no line was shown
+       again need not be handed to the frontend again either. Derived,
+       never saved.
+    */
+    inline void pictureChanged()
+    {
+        ++pictureGeneration;
+    }
+
+    /* The same for memory lines are drawn from - video and palette RAM,
+       and what is derived from sprite and fix RAM - which lines still
+       being rendered read as they stand: those lines are finished
+       first, before anything in it changes.
+    */
+    inline void pictureMemoryWrite()
+    {
+        if (linesPending)
+            finishLines();
+
+        ++pictureGeneration;
+    }
+
+    /// Show every line again, for when the picture itself went somewhere else
+    void redrawPicture();
+
+    /// Build a line ahead into its line buffer; spriteList is where the chip lists its sprites, null with sprites disabled
+    void buildLine(uint32_t scanline, uint16_t* spriteList);
+
+    /// Finish a line into the picture; built says whether its line buffer was built ahead
+    void showLine(uint32_t scanline, bool built);
+
+    static constexpr uint64_t LINE_BLACK = ~uint64_t(0);
+
+    uint64_t pictureGeneration = 1;
+    uint64_t builtGeneration[FRAMEBUFFER_HEIGHT] = {};
+    uint64_t shownGeneration[FRAMEBUFFER_HEIGHT] = {};
+    uint64_t shownBuild[FRAMEBUFFER_HEIGHT] = {};
+    bool     frameChanged = true;
+
+    /* What building and showing a line takes, recorded as the beam
+       passes: the registers it is drawn with as they stood at the
+       time, everything else being memory that does not change under a
+       line not yet rendered. With render threads, a band of lines is
+       handed to them once its last line has been shown, and the
+       emulation carries on; without, each step is rendered as soon as
+       it is recorded. Either way every line comes out the same.
+    */
+    enum LineSteps
+    {
+        LINE_BUILD    = 0x01,   // Clear the line buffer to the backdrop
+        LINE_SPRITES  = 0x02,   // and draw the line's sprites into it
+        LINE_SHOW     = 0x04,   // Resolve the line into the picture
+        LINE_BACKDROP = 0x08,   // from the backdrop alone, nothing having been built
+        LINE_FIX      = 0x10    // with the fix layer over it
+    };
+
+    struct LineJob
+    {
+        uint8_t steps = 0;
+        uint8_t autoAnimation = 0;
+        uint8_t paletteBank = 0;
+        bool    shadow = false;
+    };
+
+    /// autoAnimation of a line drawn with auto animation disabled
+    static constexpr uint8_t NO_AUTO_ANIMATION = 0xFF;
+
+    /// Lines handed to the render threads at a time
+    static constexpr uint32_t LINES_PER_BAND = 16;
+
+    void recordLine(uint32_t row);
+    void postLines(uint32_t first, uint32_t last);
+    void renderLine(uint32_t row);
+    void renderLines(uint32_t first, uint32_t last);
+
+    /// Render every line recorded so far; the picture and the line buffers are complete after this
+    void finishLines();
+
+    LineJob      lineJobs[FRAMEBUFFER_HEIGHT];
+    uint32_t     firstUnposted = 0;
+    /// Lines recorded and not yet known to be rendered
+    bool         linesPending = false;
+    VideoWorkers workers;
+
+    /// Bytes per pixel of the finished picture
+    inline uint32_t bytesPerPixel() const
+    {
+        return (pixelFormat == VideoBlit::PIXEL_FORMAT_XRGB8888) ? 4 : 2;
+    }
 
     friend DataPacker& operator<<(DataPacker& out, const Video& video);
     friend DataPacker& operator>>(DataPacker& in, Video& video);
 
-    uint16_t* paletteRamPc;
     uint8_t* fixUsageMap;
-    uint16_t* frameBuffer;
+
+    /* Lines are composed as palette indices - color plus sixteen times
+       palette number, within the bank - and only turned into pixels of
+       pixelFormat once the line is complete, from the palette, bank and
+       shadow as they stand then, the way the chip looks its line buffer
+       up in palette RAM as it shows it.
+    */
+    /// The first visible pixel of the first line, LINEBUFFER_PITCH pixels to a line
+    uint16_t* lineBuffer;
+    uint16_t* lineBufferStorage;
+    /// The finished picture, FRAMEBUFFER_WIDTH pixels of bytesPerPixel() to a line
+    void* frameBuffer;
+    VideoBlit::PixelFormat pixelFormat = VideoBlit::PIXEL_FORMAT_RGB565;
 
     // Variables to save in savestate
     uint32_t activePaletteBank;
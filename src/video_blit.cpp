@@ -0,0 +1,566 @@
+#include "inline.h"
+#include "libretro.h"
+#include "neocd_endian.h"
+#include "video_blit.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VIDEO_BLIT_X86
+#include <immintrin.h>
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__ARM_BIG_ENDIAN)
+#define VIDEO_BLIT_NEON
+#include <arm_neon.h>
+#endif
+
+// GCC and Clang only let a function use an instruction set the whole build was not compiled for when asked
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET(x) __attribute__((target(x)))
+#else
+#define TARGET(x)
+#endif
+
+namespace VideoBlit
+{
+    SpriteLine spriteLines[2][16];
+    FixRow fixRow = fixRowScalar;
+    FixBlend fixBlend = fixBlendScalar;
+    ResolveLine resolveLines[2];
+
+    uint8_t zoomLeftColumns[16][256];
+    uint8_t zoomRightColumns[16][256];
+    uint8_t zoomLeftWidth[16];
+    uint8_t reversedBits[256];
+
+    /*
+        Which of a sprite's sixteen pixels survive each horizontal zoom,
+        bit n for pixel n: zoom 0 keeps only the ninth, zoom 15 keeps
+        them all, and each step in between keeps one more.
+    */
+    static constexpr uint16_t ZOOM_MASKS[16] = {
+        0x0100, 0x0110, 0x1110, 0x1114, 0x5114, 0x5154, 0x5554, 0x5555,
+        0x5755, 0x575D, 0xD75D, 0xD7DD, 0xF7DD, 0xF7DF, 0xFFDF, 0xFFFF
+    };
+
+    /*
+        The scalar line kernels, one per zoom and flip, walked
+        out pixel by pixel at compile time: a pixel the zoom drops costs
+        nothing and each kept one knows its column before the program
+        ever runs.
+    */
+    template <uint32_t ZoomX, bool Flip, uint32_t Pixel = 0, uint32_t Column = 0>
+    struct SpriteLineKernel
+    {
+        static constexpr bool kept = ((ZOOM_MASKS[ZoomX] >> Pixel) & 1) != 0;
+        static constexpr uint32_t out = Flip ? (ZoomX - Column) : Column;
+
+        static ALWAYS_INLINE void draw(uint16_t* dst, uint32_t pixels, uint32_t pixelsB, uint32_t palette, uint32_t write)
+        {
+            if (kept)
+            {
+                const uint32_t color = (((Pixel < 8) ? pixels : pixelsB) >> ((Pixel & 7) * 4)) & 0xF;
+
+                if (color && ((write >> out) & 1))
+                    dst[out] = static_cast<uint16_t>(palette + color);
+            }
+
+            SpriteLineKernel<ZoomX, Flip, Pixel + 1, Column + (kept ? 1 : 0)>::draw(dst, pixels, pixelsB, palette, write);
+        }
+    };
+
+    template <uint32_t ZoomX, bool Flip, uint32_t Column>
+    struct SpriteLineKernel<ZoomX, Flip, 16, Column>
+    {
+        static_assert(Column == ZoomX + 1, "A sprite line is zoomX + 1 pixels wide.");
+
+        static ALWAYS_INLINE void draw(uint16_t*, uint32_t, uint32_t, uint32_t, uint32_t)
+        {
+        }
+    };
+
+    template <uint32_t ZoomX, bool Flip>
+    static void spriteLineScalar(uint16_t* dst, uint32_t pixels, uint32_t pixelsB, uint32_t palette, uint32_t write)
+    {
+        SpriteLineKernel<ZoomX, Flip>::draw(dst, pixels, pixelsB, palette, write);
+    }
+
+    template <uint32_t ZoomX>
+    struct ScalarTable
+    {
+        static void fill()
+        {
+            spriteLines[0][ZoomX] = spriteLineScalar<ZoomX, false>;
+            spriteLines[1][ZoomX] = spriteLineScalar<ZoomX, true>;
+            ScalarTable<ZoomX - 1>::fill();
+        }
+    };
+
+    template <>
+    struct ScalarTable<0>
+    {
+        static void fill()
+        {
+            spriteLines[0][0] = spriteLineScalar<0, false>;
+            spriteLines[1][0] = spriteLineScalar<0, true>;
+        }
+    };
+
+    static void fillColumnTables()
+    {
+        for (uint32_t zoomX = 0; zoomX < 16; ++zoomX)
+        {
+            const uint32_t kept = ZOOM_MASKS[zoomX];
+
+            for (uint32_t mask = 0; mask < 256; ++mask)
+            {
+                uint32_t left = 0;
+                uint32_t right = 0;
+                uint32_t leftWidth = 0;
+                uint32_t rightWidth = 0;
+
+                for (uint32_t pixel = 0; pixel < 8; ++pixel)
+                {
+                    if ((kept >> pixel) & 1)
+                        left |= ((mask >> pixel) & 1) << leftWidth++;
+
+                    if ((kept >> (pixel + 8)) & 1)
+                        right |= ((mask >> pixel) & 1) << rightWidth++;
+                }
+
+                zoomLeftColumns[zoomX][mask] = static_cast<uint8_t>(left);
+                zoomRightColumns[zoomX][mask] = static_cast<uint8_t>(right);
+                zoomLeftWidth[zoomX] = static_cast<uint8_t>(leftWidth);
+            }
+        }
+
+        for (uint32_t value = 0; value < 256; ++value)
+        {
+            uint32_t reversed = 0;
+
+            for (uint32_t bit = 0; bit < 8; ++bit)
+                reversed |= ((value >> bit) & 1) << (7 - bit);
+
+            reversedBits[value] = static_cast<uint8_t>(reversed);
+        }
+    }
+
+    void fixRowScalar(uint16_t* dst, uint32_t pixels, uint32_t palette)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            uint32_t color = (pixels >> (i * 4)) & 0xF;
+            if (color)
+                dst[i] = static_cast<uint16_t>(palette + color);
+        }
+    }
+
+    void fixBlendScalar(uint16_t* dst, const uint16_t* overlay)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            if (overlay[i])
+                dst[i] = overlay[i];
+        }
+    }
+
+    // A palette word as a sixteen bit pixel
+    static inline uint16_t color16(uint16_t c, bool shadow)
+    {
+#ifdef ABGR1555
+        uint16_t out = ((c & 0x000F) << 11) | ((c & 0x1000) >> 2) |
+            (((c & 0x00F0) << 2) | ((c & 0x2000) >> 8)) |
+            (((c & 0x0F00) >> 7) | ((c & 0x4000) >> 14));
+
+        // Five bit channels have nowhere to put the dark bit's half step.
+        if (shadow)
+            out = (out >> 1) & 0x3DEF;
+
+        return out;
+#else
+        /* Each channel is really six bits on the machine: five from the
+           palette word plus the dark bit, inverted, as the low bit shared
+           by all three - read out of Geolith's converter. Green is the one
+           channel with six bits here, so it carries the dark bit exactly;
+           red and blue have nowhere to put a half step and keep their five.
+        */
+        uint16_t out = ((c & 0x0F00) << 4) | ((c & 0x4000) >> 3) |
+            ((c & 0x00F0) << 3) | ((c & 0x2000) >> 7) |
+            ((c & 0x000F) << 1) | ((c & 0x1000) >> 12);
+
+        if (!(c & 0x8000))
+            out |= 0x0020;
+
+        /* The shadow register hangs a pulldown on every channel and the
+           screen comes out at about half brightness; halving each channel
+           is the same approximation Geolith's plain converter uses.
+        */
+        if (shadow)
+            out = (out >> 1) & 0x7BEF;
+
+        return out;
+#endif
+    }
+
+    // All six bits of every channel, each widened to eight by repeating its top bits
+    static inline uint32_t color32(uint16_t c, bool shadow)
+    {
+        const uint32_t dark = (~c >> 15) & 1;
+        uint32_t r = ((c >> 6) & 0x3C) | ((c >> 13) & 2) | dark;
+        uint32_t g = ((c >> 2) & 0x3C) | ((c >> 12) & 2) | dark;
+        uint32_t b = ((c << 2) & 0x3C) | ((c >> 11) & 2) | dark;
+
+        if (shadow)
+        {
+            r >>= 1;
+            g >>= 1;
+            b >>= 1;
+        }
+
+        r = (r << 2) | (r >> 4);
+        g = (g << 2) | (g >> 4);
+        b = (b << 2) | (b >> 4);
+
+        return (r << 16) | (g << 8) | b;
+    }
+
+    static void resolveLine16Scalar(void* dst, const uint16_t* indices, uint32_t width, const uint16_t* palette, bool shadow)
+    {
+        uint16_t* out = static_cast<uint16_t*>(dst);
+
+        for (uint32_t x = 0; x < width; ++x)
+            out[x] = color16(BIG_ENDIAN_WORD(palette[indices[x]]), shadow);
+    }
+
+    static void resolveLine32Scalar(void* dst, const uint16_t* indices, uint32_t width, const uint16_t* palette, bool shadow)
+    {
+        uint32_t* out = static_cast<uint32_t*>(dst);
+
+        for (uint32_t x = 0; x < width; ++x)
+            out[x] = color32(BIG_ENDIAN_WORD(palette[indices[x]]), shadow);
+    }
+
+#if defined(VIDEO_BLIT_X86)
+    /*
+        Both x86 versions spread the nibbles out to one byte per pixel,
+        in pixel order, and compare them with zero: a pixel left alone
+        is all ones in that mask, and the store merges the old line
+        back in under it.
+    */
+    TARGET("sse2") static inline __m128i expandNibbles(__m128i packed)
+    {
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        return _mm_unpacklo_epi8(_mm_and_si128(packed, nibble), _mm_and_si128(_mm_srli_epi16(packed, 4), nibble));
+    }
+
+    TARGET("sse2") static inline void storeMerged(uint16_t* dst, __m128i colors, __m128i clear)
+    {
+        __m128i* out = reinterpret_cast<__m128i*>(dst);
+        const __m128i old = _mm_loadu_si128(out);
+        _mm_storeu_si128(out, _mm_or_si128(_mm_and_si128(clear, old), _mm_andnot_si128(clear, colors)));
+    }
+
+    // All ones in every lane whose bit is clear in write, lane n testing bit n of bits
+    TARGET("sse2") static inline __m128i unwritten(uint32_t write, __m128i bits)
+    {
+        return _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(static_cast<short>(write)), bits), _mm_setzero_si128());
+    }
+
+    TARGET("sse2") static void spriteRowSse2(uint16_t* dst, uint32_t pixels, uint32_t pixelsB, uint32_t palette, uint32_t write)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i base = _mm_set1_epi16(static_cast<short>(palette));
+        const __m128i index = expandNibbles(_mm_set_epi32(0, 0, static_cast<int>(pixelsB), static_cast<int>(pixels)));
+        const __m128i clear = _mm_cmpeq_epi8(index, zero);
+        const __m128i bits = _mm_setr_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+
+        storeMerged(dst, _mm_or_si128(_mm_unpacklo_epi8(index, zero), base),
+                    _mm_or_si128(_mm_unpacklo_epi8(clear, clear), unwritten(write, bits)));
+        storeMerged(dst + 8, _mm_or_si128(_mm_unpackhi_epi8(index, zero), base),
+                    _mm_or_si128(_mm_unpackhi_epi8(clear, clear), unwritten(write, _mm_slli_epi16(bits, 8))));
+    }
+
+    TARGET("sse2") static void fixRowSse2(uint16_t* dst, uint32_t pixels, uint32_t palette)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i index = expandNibbles(_mm_cvtsi32_si128(static_cast<int>(pixels)));
+        const __m128i clear = _mm_cmpeq_epi8(index, zero);
+
+        storeMerged(dst, _mm_or_si128(_mm_unpacklo_epi8(index, zero), _mm_set1_epi16(static_cast<short>(palette))),
+                    _mm_unpacklo_epi8(clear, clear));
+    }
+
+    TARGET("sse2") static void fixBlendSse2(uint16_t* dst, const uint16_t* overlay)
+    {
+        const __m128i over = _mm_loadu_si128(reinterpret_cast<const __m128i*>(overlay));
+        storeMerged(dst, over, _mm_cmpeq_epi16(over, _mm_setzero_si128()));
+    }
+
+    TARGET("avx2") static void spriteRowAvx2(uint16_t* dst, uint32_t pixels, uint32_t pixelsB, uint32_t palette, uint32_t write)
+    {
+        const __m128i index = expandNibbles(_mm_set_epi32(0, 0, static_cast<int>(pixelsB), static_cast<int>(pixels)));
+        const __m256i colors = _mm256_or_si256(_mm256_cvtepu8_epi16(index), _mm256_set1_epi16(static_cast<short>(palette)));
+
+        const __m256i bits = _mm256_setr_epi16(
+            0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+            0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, static_cast<short>(0x8000));
+        const __m256i unwritten = _mm256_cmpeq_epi16(
+            _mm256_and_si256(_mm256_set1_epi16(static_cast<short>(write)), bits), _mm256_setzero_si256());
+        const __m256i clear = _mm256_or_si256(
+            _mm256_cvtepi8_epi16(_mm_cmpeq_epi8(index, _mm_setzero_si128())), unwritten);
+
+        __m256i* out = reinterpret_cast<__m256i*>(dst);
+        _mm256_storeu_si256(out, _mm256_blendv_epi8(colors, _mm256_loadu_si256(out), clear));
+    }
+
+    /*
+        Resolving goes eight pixels at a time: the palette words are
+        fetched one by one - there is no sixteen bit gather - then byte
+        swapped and converted together, with the same shifts and masks
+        as the scalar converters.
+    */
+    TARGET("sse2") static inline __m128i gatherSse2(const uint16_t* indices, const uint16_t* palette)
+    {
+        const __m128i c = _mm_setr_epi16(
+            static_cast<short>(palette[indices[0]]),
+            static_cast<short>(palette[indices[1]]),
+            static_cast<short>(palette[indices[2]]),
+            static_cast<short>(palette[indices[3]]),
+            static_cast<short>(palette[indices[4]]),
+            static_cast<short>(palette[indices[5]]),
+            static_cast<short>(palette[indices[6]]),
+            static_cast<short>(palette[indices[7]]));
+
+        return _mm_or_si128(_mm_slli_epi16(c, 8), _mm_srli_epi16(c, 8));
+    }
+
+    TARGET("sse2") static inline __m128i bitsAt(__m128i c, int mask)
+    {
+        return _mm_and_si128(c, _mm_set1_epi16(static_cast<short>(mask)));
+    }
+
+    TARGET("sse2") static void resolveLine16Sse2(void* dst, const uint16_t* indices, uint32_t width, const uint16_t* palette, bool shadow)
+    {
+        __m128i* out = static_cast<__m128i*>(dst);
+        const __m128i shadowMask = _mm_set1_epi16(0x7BEF);
+
+        for (uint32_t x = 0; x < width; x += 8)
+        {
+            const __m128i c = gatherSse2(indices + x, palette);
+
+            __m128i color = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi16(bitsAt(c, 0x0F00), 4), _mm_srli_epi16(bitsAt(c, 0x4000), 3)),
+                _mm_or_si128(_mm_slli_epi16(bitsAt(c, 0x00F0), 3), _mm_srli_epi16(bitsAt(c, 0x2000), 7)));
+            color = _mm_or_si128(color,
+                _mm_or_si128(_mm_slli_epi16(bitsAt(c, 0x000F), 1), _mm_srli_epi16(bitsAt(c, 0x1000), 12)));
+            color = _mm_or_si128(color, _mm_srli_epi16(_mm_andnot_si128(c, _mm_set1_epi16(static_cast<short>(0x8000))), 10));
+
+            if (shadow)
+                color = _mm_and_si128(_mm_srli_epi16(color, 1), shadowMask);
+
+            _mm_storeu_si128(out++, color);
+        }
+    }
+
+    TARGET("sse2") static inline __m128i widenChannel(__m128i channel, bool shadow)
+    {
+        if (shadow)
+            channel = _mm_srli_epi16(channel, 1);
+
+        return _mm_or_si128(_mm_slli_epi16(channel, 2), _mm_srli_epi16(channel, 4));
+    }
+
+    TARGET("sse2") static void resolveLine32Sse2(void* dst, const uint16_t* indices, uint32_t width, const uint16_t* palette, bool shadow)
+    {
+        __m128i* out = static_cast<__m128i*>(dst);
+
+        for (uint32_t x = 0; x < width; x += 8)
+        {
+            const __m128i c = gatherSse2(indices + x, palette);
+            const __m128i dark = _mm_srli_epi16(_mm_andnot_si128(c, _mm_set1_epi16(static_cast<short>(0x8000))), 15);
+
+            const __m128i r = widenChannel(_mm_or_si128(dark,
+                _mm_or_si128(bitsAt(_mm_srli_epi16(c, 6), 0x3C), bitsAt(_mm_srli_epi16(c, 13), 2))), shadow);
+            const __m128i g = widenChannel(_mm_or_si128(dark,
+                _mm_or_si128(bitsAt(_mm_srli_epi16(c, 2), 0x3C), bitsAt(_mm_srli_epi16(c, 12), 2))), shadow);
+            const __m128i b = widenChannel(_mm_or_si128(dark,
+                _mm_or_si128(bitsAt(_mm_slli_epi16(c, 2), 0x3C), bitsAt(_mm_srli_epi16(c, 11), 2))), shadow);
+
+            const __m128i greenBlue = _mm_or_si128(_mm_slli_epi16(g, 8), b);
+
+            _mm_storeu_si128(out++, _mm_unpacklo_epi16(greenBlue, r));
+            _mm_storeu_si128(out++, _mm_unpackhi_epi16(greenBlue, r));
+        }
+    }
+#endif // VIDEO_BLIT_X86
+
+#if defined(VIDEO_BLIT_NEON)
+    // The same on ARM, eight pixels to a store.
+    static inline void storeEightNeon(uint16_t* dst, uint8x8_t index, uint32_t palette, uint32_t write)
+    {
+        static const uint16_t BITS[8] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+
+        const uint16x8_t colors = vorrq_u16(vmovl_u8(index), vdupq_n_u16(static_cast<uint16_t>(palette)));
+        const uint16x8_t clear = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vceq_u8(index, vdup_n_u8(0)))));
+        const uint16x8_t written = vtstq_u16(vdupq_n_u16(static_cast<uint16_t>(write & 0xFF)), vld1q_u16(BITS));
+        const uint16x8_t keep = vornq_u16(clear, written);
+
+        vst1q_u16(dst, vbslq_u16(keep, vld1q_u16(dst), colors));
+    }
+
+    static void spriteRowNeon(uint16_t* dst, uint32_t pixels, uint32_t pixelsB, uint32_t palette, uint32_t write)
+    {
+        const uint8x8_t packed = vcreate_u8(static_cast<uint64_t>(pixels) | (static_cast<uint64_t>(pixelsB) << 32));
+        const uint8x8x2_t index = vzip_u8(vand_u8(packed, vdup_n_u8(0x0F)), vshr_n_u8(packed, 4));
+
+        storeEightNeon(dst, index.val[0], palette, write);
+        storeEightNeon(dst + 8, index.val[1], palette, write >> 8);
+    }
+
+    static void fixRowNeon(uint16_t* dst, uint32_t pixels, uint32_t palette)
+    {
+        const uint8x8_t packed = vcreate_u8(static_cast<uint64_t>(pixels));
+        const uint8x8x2_t index = vzip_u8(vand_u8(packed, vdup_n_u8(0x0F)), vshr_n_u8(packed, 4));
+
+        storeEightNeon(dst, index.val[0], palette, 0xFF);
+    }
+
+    static void fixBlendNeon(uint16_t* dst, const uint16_t* overlay)
+    {
+        const uint16x8_t over = vld1q_u16(overlay);
+        vst1q_u16(dst, vbslq_u16(vceqq_u16(over, vdupq_n_u16(0)), vld1q_u16(dst), over));
+    }
+
+    static inline uint16x8_t gatherNeon(const uint16_t* indices, const uint16_t* palette)
+    {
+        uint16_t c[8];
+
+        for (uint32_t i = 0; i < 8; ++i)
+            c[i] = palette[indices[i]];
+
+        return vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(vld1q_u16(c))));
+    }
+
+    static inline uint16x8_t bitsAtNeon(uint16x8_t c, uint16_t mask)
+    {
+        return vandq_u16(c, vdupq_n_u16(mask));
+    }
+
+    static void resolveLine16Neon(void* dst, const uint16_t* indices, uint32_t width, const uint16_t* palette, bool shadow)
+    {
+        uint16_t* out = static_cast<uint16_t*>(dst);
+
+        for (uint32_t x = 0; x < width; x += 8)
+        {
+            const uint16x8_t c = gatherNeon(indices + x, palette);
+
+            uint16x8_t color = vorrq_u16(
+                vorrq_u16(vshlq_n_u16(bitsAtNeon(c, 0x0F00), 4), vshrq_n_u16(bitsAtNeon(c, 0x4000), 3)),
+                vorrq_u16(vshlq_n_u16(bitsAtNeon(c, 0x00F0), 3), vshrq_n_u16(bitsAtNeon(c, 0x2000), 7)));
+            color = vorrq_u16(color,
+                vorrq_u16(vshlq_n_u16(bitsAtNeon(c, 0x000F), 1), vshrq_n_u16(bitsAtNeon(c, 0x1000), 12)));
+            color = vorrq_u16(color, vshrq_n_u16(vbicq_u16(vdupq_n_u16(0x8000), c), 10));
+
+            if (shadow)
+                color = bitsAtNeon(vshrq_n_u16(color, 1), 0x7BEF);
+
+            vst1q_u16(out + x, color);
+        }
+    }
+
+    static inline uint16x8_t widenChannelNeon(uint16x8_t channel, bool shadow)
+    {
+        if (shadow)
+            channel = vshrq_n_u16(channel, 1);
+
+        return vorrq_u16(vshlq_n_u16(channel, 2), vshrq_n_u16(channel, 4));
+    }
+
+    static void resolveLine32Neon(void* dst, const uint16_t* indices, uint32_t width, const uint16_t* palette, bool shadow)
+    {
+        uint32_t* out = static_cast<uint32_t*>(dst);
+
+        for (uint32_t x = 0; x < width; x += 8)
+        {
+            const uint16x8_t c = gatherNeon(indices + x, palette);
+            const uint16x8_t dark = vshrq_n_u16(vbicq_u16(vdupq_n_u16(0x8000), c), 15);
+
+            const uint16x8_t r = widenChannelNeon(vorrq_u16(dark,
+                vorrq_u16(bitsAtNeon(vshrq_n_u16(c, 6), 0x3C), bitsAtNeon(vshrq_n_u16(c, 13), 2))), shadow);
+            const uint16x8_t g = widenChannelNeon(vorrq_u16(dark,
+                vorrq_u16(bitsAtNeon(vshrq_n_u16(c, 2), 0x3C), bitsAtNeon(vshrq_n_u16(c, 12), 2))), shadow);
+            const uint16x8_t b = widenChannelNeon(vorrq_u16(dark,
+                vorrq_u16(bitsAtNeon(vshlq_n_u16(c, 2), 0x3C), bitsAtNeon(vshrq_n_u16(c, 11), 2))), shadow);
+
+            const uint16x8x2_t pixels = vzipq_u16(vorrq_u16(vshlq_n_u16(g, 8), b), r);
+
+            vst1q_u32(out + x, vreinterpretq_u32_u16(pixels.val[0]));
+            vst1q_u32(out + x + 4, vreinterpretq_u32_u16(pixels.val[1]));
+        }
+    }
+#endif // VIDEO_BLIT_NEON
+
+    /// A flipped full width line is the same sixteen pixels mirrored
+    template <void (*Row)(uint16_t*, uint32_t, uint32_t, uint32_t, uint32_t), bool Flip>
+    static void spriteLineRow(uint16_t* dst, uint32_t pixels, uint32_t pixelsB, uint32_t palette, uint32_t write)
+    {
+        if (Flip)
+            reverseRow(pixels, pixelsB);
+
+        Row(dst, pixels, pixelsB, palette, write);
+    }
+
+    const char* select(uint64_t features)
+    {
+        ScalarTable<15>::fill();
+        fillColumnTables();
+        fixRow = fixRowScalar;
+        fixBlend = fixBlendScalar;
+        resolveLines[PIXEL_FORMAT_RGB565] = resolveLine16Scalar;
+        resolveLines[PIXEL_FORMAT_XRGB8888] = resolveLine32Scalar;
+
+#if defined(VIDEO_BLIT_X86)
+        if (features & (RETRO_SIMD_AVX2 | RETRO_SIMD_SSE2))
+        {
+#if !defined(ABGR1555)
+            resolveLines[PIXEL_FORMAT_RGB565] = resolveLine16Sse2;
+#endif
+            resolveLines[PIXEL_FORMAT_XRGB8888] = resolveLine32Sse2;
+        }
+
+        if (features & RETRO_SIMD_AVX2)
+        {
+            spriteLines[0][15] = spriteLineRow<spriteRowAvx2, false>;
+            spriteLines[1][15] = spriteLineRow<spriteRowAvx2, true>;
+            fixRow = fixRowSse2;
+            fixBlend = fixBlendSse2;
+            return "AVX2";
+        }
+
+        if (features & RETRO_SIMD_SSE2)
+        {
+            spriteLines[0][15] = spriteLineRow<spriteRowSse2, false>;
+            spriteLines[1][15] = spriteLineRow<spriteRowSse2, true>;
+            fixRow = fixRowSse2;
+            fixBlend = fixBlendSse2;
+            return "SSE2";
+        }
+#endif
+
+#if defined(VIDEO_BLIT_NEON)
+        if (features & (RETRO_SIMD_NEON | RETRO_SIMD_ASIMD))
+        {
+            spriteLines[0][15] = spriteLineRow<spriteRowNeon, false>;
+            spriteLines[1][15] = spriteLineRow<spriteRowNeon, true>;
+            fixRow = fixRowNeon;
+            fixBlend = fixBlendNeon;
+#if !defined(ABGR1555)
+            resolveLines[PIXEL_FORMAT_RGB565] = resolveLine16Neon;
+#endif
+            resolveLines[PIXEL_FORMAT_XRGB8888] = resolveLine32Neon;
+            return "NEON";
+        }
+#endif
+
+        return "scalar";
+    }
+} // namespace VideoBlit
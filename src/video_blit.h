@@ -0,0 +1,103 @@
+#ifndef VIDEO_BLIT_H
+#define VIDEO_BLIT_H
+
+#include <cstdint>
+
+/*
+    The innermost loops of the renderer: a line of one sprite or a row
+    of eight fix pixels, packed four bits to a pixel with pixel n in
+    nibble n, stored into a line buffer as palette indices wherever the
+    pixel is not colour zero, and the finished line turned into colors
+    in one pass at the end. The scalar versions are the reference; the
+    others must write exactly what they write, and which one runs is
+    picked once from what the processor says it can do.
+*/
+namespace VideoBlit
+{
+    /**
+     * One line of a sprite, shrunk to zoomX + 1 pixels and stored from dst[0] on.
+     * Pixels 0-7 are in pixels and 8-15 in pixelsB. A flipped sprite stores
+     * the same pixels right to left. Nothing is clipped: the line is always
+     * written whole, into the line buffer's guard band where it overhangs.
+     * Only the columns set in write, bit n for dst[n], are stored at all.
+     * A pixel of color n is stored as palette + n.
+     */
+    typedef void (*SpriteLine)(uint16_t* dst, uint32_t pixels, uint32_t pixelsB, uint32_t palette, uint32_t write);
+
+    /// Eight fix pixels at dst[0] to dst[7]
+    typedef void (*FixRow)(uint16_t* dst, uint32_t pixels, uint32_t palette);
+
+    /// Eight indices from overlay over dst[0] to dst[7], wherever the overlay is not zero
+    typedef void (*FixBlend)(uint16_t* dst, const uint16_t* overlay);
+
+    /**
+     * width pixels of a line buffer into finished pixels at dst, each index
+     * looked up in palette - a bank of palette RAM as the 68000 sees it,
+     * big endian words - and halved in brightness under shadow. width is a
+     * multiple of sixteen.
+     */
+    typedef void (*ResolveLine)(void* dst, const uint16_t* indices, uint32_t width, const uint16_t* palette, bool shadow);
+
+    /// The pixel formats a line can be resolved to
+    enum PixelFormat
+    {
+        PIXEL_FORMAT_RGB565 = 0,
+        PIXEL_FORMAT_XRGB8888 = 1
+    };
+
+    /// Sprite line kernels, by [flipped][zoomX]
+    extern SpriteLine spriteLines[2][16];
+    extern FixRow fixRow;
+    extern FixBlend fixBlend;
+
+    /// Line resolvers, by PixelFormat
+    extern ResolveLine resolveLines[2];
+
+    /**
+     * @brief Pick the fastest kernels the processor supports
+     * @param features RETRO_SIMD_* flags, as cpu_features_get() returns them; zero selects the scalar reference
+     * @return Name of the kernel set, for the log
+     */
+    const char* select(uint64_t features);
+
+    /*
+        Which of the zoomX + 1 columns a sprite line lands on get an
+        opaque pixel, bit n for column n, from the mask of its sixteen
+        opaque pixels: the two halves of the mask are squeezed through
+        the zoom separately and the right half shifted past the left.
+    */
+    extern uint8_t zoomLeftColumns[16][256];
+    extern uint8_t zoomRightColumns[16][256];
+    extern uint8_t zoomLeftWidth[16];
+    extern uint8_t reversedBits[256];
+
+    inline uint32_t opaqueColumns(uint32_t opaque, uint32_t zoomX, bool flip)
+    {
+        uint32_t columns = zoomLeftColumns[zoomX][opaque & 0xFF]
+            | (zoomRightColumns[zoomX][opaque >> 8] << zoomLeftWidth[zoomX]);
+
+        if (flip)
+            columns = ((reversedBits[columns & 0xFF] << 8) | reversedBits[columns >> 8]) >> (15 - zoomX);
+
+        return columns;
+    }
+
+    void fixRowScalar(uint16_t* dst, uint32_t pixels, uint32_t palette);
+    void fixBlendScalar(uint16_t* dst, const uint16_t* overlay);
+
+    /// Mirror a row of sixteen pixels, for sprites drawn flipped
+    inline void reverseRow(uint32_t& pixels, uint32_t& pixelsB)
+    {
+        auto reverse = [](uint32_t value) {
+            value = ((value >> 4) & 0x0F0F0F0F) | ((value & 0x0F0F0F0F) << 4);
+            value = ((value >> 8) & 0x00FF00FF) | ((value & 0x00FF00FF) << 8);
+            return (value >> 16) | (value << 16);
+        };
+
+        uint32_t left = reverse(pixelsB);
+        pixelsB = reverse(pixels);
+        pixels = left;
+    }
+} // namespace VideoBlit
+
+#endif // VIDEO_BLIT_H
@@ -0,0 +1,153 @@
+#include "video.h"
+#include "video_workers.h"
+
+VideoWorkers::VideoWorkers(Video& video) :
+    video(video)
+{
+}
+
+VideoWorkers::~VideoWorkers()
+{
+    resize(0);
+}
+
+#ifdef HAVE_THREADS
+
+uint32_t VideoWorkers::automaticCount()
+{
+    const uint32_t processors = std::thread::hardware_concurrency();
+
+    if (processors < 2)
+        return 0;
+
+    return (processors - 1 < MAX_THREADS) ? processors - 1 : MAX_THREADS;
+}
+
+void VideoWorkers::resize(uint32_t count)
+{
+    if (count > MAX_THREADS)
+        count = MAX_THREADS;
+
+    if (count == threads.size())
+        return;
+
+    finish();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    threads.clear();
+    stopping = false;
+
+    for (uint32_t i = 0; i < count; ++i)
+        threads.emplace_back(&VideoWorkers::work, this);
+}
+
+uint32_t VideoWorkers::size() const
+{
+    return static_cast<uint32_t>(threads.size());
+}
+
+void VideoWorkers::post(uint32_t first, uint32_t last)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queueFirst[queueTail % QUEUE_SIZE] = static_cast<uint8_t>(first);
+        queueLast[queueTail % QUEUE_SIZE] = static_cast<uint8_t>(last);
+        ++queueTail;
+    }
+
+    wake.notify_one();
+}
+
+void VideoWorkers::finish()
+{
+    uint32_t first;
+    uint32_t last;
+
+    while (takeBand(first, last))
+    {
+        video.renderLines(first, last);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        --rendering;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !rendering; });
+}
+
+bool VideoWorkers::takeBand(uint32_t& first, uint32_t& last)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (queueHead == queueTail)
+        return false;
+
+    first = queueFirst[queueHead % QUEUE_SIZE];
+    last = queueLast[queueHead % QUEUE_SIZE];
+    ++queueHead;
+    ++rendering;
+
+    return true;
+}
+
+void VideoWorkers::work()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;)
+    {
+        wake.wait(lock, [this] { return stopping || (queueHead != queueTail); });
+
+        if (queueHead == queueTail)
+            return;
+
+        const uint32_t first = queueFirst[queueHead % QUEUE_SIZE];
+        const uint32_t last = queueLast[queueHead % QUEUE_SIZE];
+        ++queueHead;
+        ++rendering;
+
+        lock.unlock();
+        video.renderLines(first, last);
+        lock.lock();
+
+        if (!--rendering)
+            idle.notify_all();
+    }
+}
+
+#else // HAVE_THREADS
+
+uint32_t VideoWorkers::automaticCount()
+{
+    return 0;
+}
+
+void VideoWorkers::resize(uint32_t count)
+{
+    (void)count;
+}
+
+uint32_t VideoWorkers::size() const
+{
+    return 0;
+}
+
+void VideoWorkers::post(uint32_t first, uint32_t last)
+{
+    video.renderLines(first, last);
+}
+
+void VideoWorkers::finish()
+{
+}
+
+#endif // HAVE_THREADS
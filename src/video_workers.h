@@ -0,0 +1,76 @@
+#ifndef VIDEO_WORKERS_H
+#define VIDEO_WORKERS_H
+
+#include <cstdint>
+
+#ifdef HAVE_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+class Video;
+
+/*
+    A few threads that render bands of lines the emulation has finished
+    recording, while the emulation goes on to the next ones. Bands are
+    taken in the order they were posted; finish() runs whatever no
+    thread has picked up yet on the calling thread and returns once
+    every band is done. With no threads - the default, and all there is
+    in a build without HAVE_THREADS - nothing is ever posted and lines
+    are rendered where they are recorded.
+*/
+class VideoWorkers
+{
+public:
+    explicit VideoWorkers(Video& video);
+    ~VideoWorkers();
+
+    // Non copyable
+    VideoWorkers(const VideoWorkers&) = delete;
+
+    // Non copyable
+    VideoWorkers& operator=(const VideoWorkers&) = delete;
+
+    /// Threads worth starting on this machine, leaving one processor to the emulation
+    static uint32_t automaticCount();
+
+    /// Stop the threads running and start count new ones; zero renders inline
+    void resize(uint32_t count);
+
+    uint32_t size() const;
+
+    /// Have rows first to last rendered
+    void post(uint32_t first, uint32_t last);
+
+    /// Render everything posted, helping out on the calling thread
+    void finish();
+
+    /// Most threads there is any point in starting
+    static constexpr uint32_t MAX_THREADS = 4;
+
+private:
+    Video& video;
+
+#ifdef HAVE_THREADS
+    void work();
+    bool takeBand(uint32_t& first, uint32_t& last);
+
+    // Never more bands than lines in flight at once
+    static constexpr uint32_t QUEUE_SIZE = 256;
+
+    std::vector<std::thread> threads;
+    std::mutex               mutex;
+    std::condition_variable  wake;
+    std::condition_variable  idle;
+    uint8_t                  queueFirst[QUEUE_SIZE];
+    uint8_t                  queueLast[QUEUE_SIZE];
+    uint32_t                 queueHead = 0;
+    uint32_t                 queueTail = 0;
+    uint32_t                 rendering = 0;
+    bool                     stopping = false;
+#endif
+};
+
+#endif // VIDEO_WORKERS_H
@@ -28,6 +28,20 @@ extern "C"
         return 0;
     }
 
+    /*
+        The Z80 is run up to the next thing that can change what it reads - the
+        sound command arriving, a YM2610 timer expiring - so within one run the
+        only port that moves by itself is status port A, while its busy flag is
+        up. The Z80 core fast-forwards loops polling a steady port.
+    */
+    int io_read_steady(uint16_t port)
+    {
+        if ((port & 0xFF) == 0x04)
+            return !(YM2610Read(0) & 0x80);
+
+        return 1;
+    }
+
     void io_write_byte_8(uint16_t port, uint16_t value)
     {
         switch (port & 0xFF)
@@ -66,11 +80,6 @@ extern "C"
         }
     }
 
-    uint8_t program_read_byte_8(uint16_t addr)
-    {
-        return neocd->memory.z80Ram[addr];
-    }
-
     void program_write_byte_8(uint16_t addr, uint8_t value)
     {
         neocd->memory.z80Ram[addr] = value;
@@ -16,9 +16,10 @@ extern "C" {
 
 uint16_t io_read_byte_8(uint16_t port);
 
-void io_write_byte_8(uint16_t port, uint16_t value);
+/// Whether reading port reads the same until the Z80's run ends, short of a write by the Z80 itself
+int io_read_steady(uint16_t port);
 
-uint8_t program_read_byte_8(uint16_t addr);
+void io_write_byte_8(uint16_t port, uint16_t value);
 
 void program_write_byte_8(uint16_t addr, uint8_t value);
 
@@ -0,0 +1,277 @@
+/* Lockstep check of the block cache against the interpreter.
+ *
+ * Runs the core twice over every timeslice, from the same registers and
+ * the same memory: once as the plain interpreter, with the block cache
+ * off, and once with the cache on. After each slice
+ * the two register files, the cycles each billed and the 64KiB of RAM
+ * must be identical; the first difference is reported with the seed and
+ * the slice that found it.
+ *
+ * The programs are pseudo-random words, with the vectors pointing back
+ * into them, so they take exceptions, write over their own code and
+ * wander off into the callback-only part of the bus. Each seed also gets
+ * a tight loop of register instructions closed by a DBRA, so its traces
+ * are replayed over and over rather than only recorded. Slices are of random
+ * length and an interrupt is raised now and then between them.
+ *
+ * Between the two runs the RAM is put back with memcpy(), behind the
+ * cache's back. That is safe here: every block the cache still holds was
+ * recorded from that same memory, and anything the interpreter run wrote
+ * over a recorded block forgot the block as it wrote.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "m68k.h"
+
+#define RAM_SIZE    0x10000u
+#define CODE_BASE   0x000400u
+#define LOOP_BASE   0x008000u
+#define SEEDS       48
+#define SLICES      4000
+
+static uint8_t ram[RAM_SIZE];
+static uint32_t rng;
+
+static uint32_t next_random(void)
+{
+   rng ^= rng << 13;
+   rng ^= rng >> 17;
+   rng ^= rng << 5;
+   return rng;
+}
+
+/* Outside the RAM: a fixed function of the address, and writes vanish */
+static uint8_t rd8(uint32_t a)
+{
+   a &= 0x00ffffffu;
+   if (a < RAM_SIZE)
+      return ram[a];
+   a *= 2654435761u;
+   return (uint8_t)(a >> 13);
+}
+
+static void wr8(uint32_t a, uint32_t v)
+{
+   a &= 0x00ffffffu;
+   if (a < RAM_SIZE)
+   {
+      ram[a] = (uint8_t)v;
+      m68k_invalidate_code(a, 1);
+   }
+}
+
+uint32_t m68k_read_memory_8(uint32_t a)
+{
+   return rd8(a);
+}
+
+uint32_t m68k_read_memory_16(uint32_t a)
+{
+   return ((uint32_t)rd8(a) << 8) | rd8(a + 1);
+}
+
+uint32_t m68k_read_memory_32(uint32_t a)
+{
+   return (m68k_read_memory_16(a) << 16) | m68k_read_memory_16(a + 2);
+}
+
+uint32_t m68k_read_disassembler_8(uint32_t a)
+{
+   return m68k_read_memory_8(a);
+}
+
+uint32_t m68k_read_disassembler_16(uint32_t a)
+{
+   return m68k_read_memory_16(a);
+}
+
+uint32_t m68k_read_disassembler_32(uint32_t a)
+{
+   return m68k_read_memory_32(a);
+}
+
+void m68k_write_memory_8(uint32_t a, uint32_t v)
+{
+   wr8(a, v);
+}
+
+void m68k_write_memory_16(uint32_t a, uint32_t v)
+{
+   wr8(a, v >> 8);
+   wr8(a + 1, v);
+}
+
+void m68k_write_memory_32(uint32_t a, uint32_t v)
+{
+   m68k_write_memory_16(a, v >> 16);
+   m68k_write_memory_16(a + 2, v & 0xffffu);
+}
+
+void m68k_write_memory_32_pd(uint32_t a, uint32_t v)
+{
+   m68k_write_memory_16(a + 2, v & 0xffffu);
+   m68k_write_memory_16(a, v >> 16);
+}
+
+/* The two hooks m68kconf.h names. */
+int neocd_get_vector(int level)
+{
+   (void)level;
+   return M68K_INT_ACK_AUTOVECTOR;
+}
+
+int neocd_illegal_handler(int opcode)
+{
+   (void)opcode;
+   return 0;
+}
+
+static void put16(uint32_t a, uint32_t v)
+{
+   ram[a] = (uint8_t)(v >> 8);
+   ram[a + 1] = (uint8_t)v;
+}
+
+static void put32(uint32_t a, uint32_t v)
+{
+   put16(a, v >> 16);
+   put16(a + 2, v & 0xffffu);
+}
+
+/* A register-to-register instruction: a random word from one of the ALU,
+   shift, quick and MOVE lines with its operands forced to data registers.
+   A few come out as DIVU by zero or the like, and leave the loop. */
+static uint32_t register_op(void)
+{
+   static const uint16_t lines[] = {
+      0x8000, 0x9000, 0xb000, 0xc000, 0xd000, 0xe000, 0x5000
+   };
+   const uint32_t r = next_random();
+   const uint32_t pick = r % (sizeof(lines) / sizeof(lines[0]) + 2);
+
+   if (pick == sizeof(lines) / sizeof(lines[0]))
+      return 0x7000 | ((r >> 8) & 0x0eff);   /* moveq */
+   if (pick > sizeof(lines) / sizeof(lines[0]))
+      return 0x2000 | ((r >> 8) & 0x0e07);   /* move.l dy,dx */
+   return lines[pick] | ((r >> 8) & 0x0fc7);
+}
+
+static void build(uint32_t seed)
+{
+   uint32_t a;
+
+   rng = seed * 2654435761u + 1;
+   for (a = 0; a < RAM_SIZE; a += 2)
+      put16(a, next_random());
+
+   /* Stack, then every vector back into the code */
+   put32(0, 0x00007ff0u);
+   put32(4, CODE_BASE);
+   for (a = 8; a < CODE_BASE; a += 4)
+      put32(a, CODE_BASE + (next_random() & 0x7ffeu));
+
+   /* A loop round eight register instructions, taken up to 0x10000
+      times: moveq #-1,d7; body; dbra d7,body */
+   put16(CODE_BASE, 0x7eff);
+   put16(CODE_BASE + 2, 0x4ef9);
+   put32(CODE_BASE + 4, LOOP_BASE);
+   for (a = LOOP_BASE; a < LOOP_BASE + 16; a += 2)
+      put16(a, register_op() & ~0x0e00u);
+   put16(LOOP_BASE + 16, 0x51cf);
+   put16(LOOP_BASE + 18, (uint32_t)(-18) & 0xffffu);
+}
+
+static void describe(const char* what, const uint8_t* a, const uint8_t* b, unsigned size)
+{
+   unsigned i;
+
+   for (i = 0; i < size; i++)
+   {
+      if (a[i] != b[i])
+      {
+         printf("  %s differs at byte %u: %02x interpreted, %02x cached\n", what, i, a[i], b[i]);
+         return;
+      }
+   }
+}
+
+int main(void)
+{
+   static uint8_t ram_before[RAM_SIZE];
+   static uint8_t ram_interpreted[RAM_SIZE];
+   unsigned char* before;
+   unsigned char* interpreted;
+   unsigned char* cached;
+   unsigned size;
+   unsigned seed;
+   unsigned page;
+
+   m68k_init();
+   m68k_set_cpu_type(M68K_CPU_TYPE_68000);
+
+   for (page = 0; page < RAM_SIZE / M68K_PAGE_SIZE; page++)
+   {
+      m68k_set_read_page(page, &ram[page * M68K_PAGE_SIZE]);
+      m68k_set_write_page(page, &ram[page * M68K_PAGE_SIZE]);
+   }
+
+   size = m68k_context_size();
+   before = malloc(size);
+   interpreted = malloc(size);
+   cached = malloc(size);
+
+   for (seed = 1; seed <= SEEDS; seed++)
+   {
+      unsigned slice;
+
+      build(seed);
+      m68k_invalidate_code(0, 0x1000000);
+      m68k_pulse_reset();
+
+      for (slice = 0; slice < SLICES; slice++)
+      {
+         const int cycles = 1 + (int)(next_random() % 400);
+         int used_interpreted;
+         int used_cached;
+
+         if ((slice % 97) == 96)
+            m68k_set_irq(1 + next_random() % 7);
+         else if ((slice % 97) == 0)
+            m68k_set_irq(0);
+         if ((slice % 1000) == 999)
+            m68k_pulse_reset();
+
+         m68k_get_context(before);
+         memcpy(ram_before, ram, RAM_SIZE);
+
+         m68k_set_block_cache(0);
+         used_interpreted = m68k_execute(cycles);
+         m68k_get_context(interpreted);
+         memcpy(ram_interpreted, ram, RAM_SIZE);
+
+         m68k_set_context(before);
+         memcpy(ram, ram_before, RAM_SIZE);
+
+         m68k_set_block_cache(1);
+         used_cached = m68k_execute(cycles);
+         m68k_get_context(cached);
+
+         if (used_interpreted != used_cached ||
+             memcmp(interpreted, cached, size) ||
+             memcmp(ram_interpreted, ram, RAM_SIZE))
+         {
+            printf("68000 block cache lockstep: MISMATCH at seed %u, slice %u\n", seed, slice);
+            printf("  cycles %d interpreted, %d cached\n", used_interpreted, used_cached);
+            describe("context", interpreted, cached, size);
+            describe("ram", ram_interpreted, ram, RAM_SIZE);
+            return 1;
+         }
+      }
+   }
+
+   printf("68000 block cache lockstep: ok (%u seeds, %u slices each)\n", SEEDS, SLICES);
+   return 0;
+}
@@ -0,0 +1,364 @@
+/* Check of the timeslice callback against separate calls.
+ *
+ * Runs the core twice over the same list of timeslices, from the same
+ * registers and the same memory: once calling m68k_execute() for every
+ * slice, and once letting the timeslice callback hand the core the next
+ * slice from inside m68k_execute(), calling it again only when the core
+ * comes back out. Whatever is done between two slices - raising or
+ * dropping an interrupt, pulsing reset - is done at the same point of
+ * both runs, from the callback in the second one.
+ *
+ * The cycles billed for each slice and the register file at its end must
+ * be the same in both runs, and so must the RAM once a seed is done. The
+ * core has to come back out for every interrupt it takes, every reset and
+ * every STOP, so the random programs - the same kind as in cache_lockstep.c,
+ * with the block cache on - go through all three, and the run fails as
+ * well if the second one never went on from one slice to the next.
+ *
+ * Last, a slice a write ends with m68k_end_timeslice() has to bill the
+ * cycles it ran, not the ones it had left.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "m68k.h"
+
+#define RAM_SIZE    0x10000u
+#define END_PORT    0xff0000u
+#define CODE_BASE   0x000400u
+#define LOOP_BASE   0x008000u
+#define SEEDS       32
+#define SLICES      4000
+
+static uint8_t ram[RAM_SIZE];
+static uint32_t rng;
+
+/* The slices of one seed, and what the first run saw at the end of each */
+static int slice_cycles[SLICES];
+static int slice_used[SLICES];
+static unsigned char* slice_context[SLICES];
+static unsigned context_size;
+
+/* Where the second run is */
+static unsigned current;
+static int ended;
+static int failed;
+
+static uint32_t next_random(void)
+{
+   rng ^= rng << 13;
+   rng ^= rng >> 17;
+   rng ^= rng << 5;
+   return rng;
+}
+
+/* Outside the RAM: a fixed function of the address, and writes vanish */
+static uint8_t rd8(uint32_t a)
+{
+   a &= 0x00ffffffu;
+   if (a < RAM_SIZE)
+      return ram[a];
+   a *= 2654435761u;
+   return (uint8_t)(a >> 13);
+}
+
+static void wr8(uint32_t a, uint32_t v)
+{
+   a &= 0x00ffffffu;
+   if (a < RAM_SIZE)
+   {
+      ram[a] = (uint8_t)v;
+      m68k_invalidate_code(a, 1);
+   }
+   else if (a == END_PORT)
+      m68k_end_timeslice();
+}
+
+uint32_t m68k_read_memory_8(uint32_t a)
+{
+   return rd8(a);
+}
+
+uint32_t m68k_read_memory_16(uint32_t a)
+{
+   return ((uint32_t)rd8(a) << 8) | rd8(a + 1);
+}
+
+uint32_t m68k_read_memory_32(uint32_t a)
+{
+   return (m68k_read_memory_16(a) << 16) | m68k_read_memory_16(a + 2);
+}
+
+uint32_t m68k_read_disassembler_8(uint32_t a)
+{
+   return m68k_read_memory_8(a);
+}
+
+uint32_t m68k_read_disassembler_16(uint32_t a)
+{
+   return m68k_read_memory_16(a);
+}
+
+uint32_t m68k_read_disassembler_32(uint32_t a)
+{
+   return m68k_read_memory_32(a);
+}
+
+void m68k_write_memory_8(uint32_t a, uint32_t v)
+{
+   wr8(a, v);
+}
+
+void m68k_write_memory_16(uint32_t a, uint32_t v)
+{
+   wr8(a, v >> 8);
+   wr8(a + 1, v);
+}
+
+void m68k_write_memory_32(uint32_t a, uint32_t v)
+{
+   m68k_write_memory_16(a, v >> 16);
+   m68k_write_memory_16(a + 2, v & 0xffffu);
+}
+
+void m68k_write_memory_32_pd(uint32_t a, uint32_t v)
+{
+   m68k_write_memory_16(a + 2, v & 0xffffu);
+   m68k_write_memory_16(a, v >> 16);
+}
+
+/* The two hooks m68kconf.h names. */
+int neocd_get_vector(int level)
+{
+   (void)level;
+   return M68K_INT_ACK_AUTOVECTOR;
+}
+
+int neocd_illegal_handler(int opcode)
+{
+   (void)opcode;
+   return 0;
+}
+
+static void put16(uint32_t a, uint32_t v)
+{
+   ram[a] = (uint8_t)(v >> 8);
+   ram[a + 1] = (uint8_t)v;
+}
+
+static void put32(uint32_t a, uint32_t v)
+{
+   put16(a, v >> 16);
+   put16(a + 2, v & 0xffffu);
+}
+
+/* A register-to-register instruction, as in cache_lockstep.c */
+static uint32_t register_op(void)
+{
+   static const uint16_t lines[] = {
+      0x8000, 0x9000, 0xb000, 0xc000, 0xd000, 0xe000, 0x5000
+   };
+   const uint32_t r = next_random();
+   const uint32_t pick = r % (sizeof(lines) / sizeof(lines[0]) + 2);
+
+   if (pick == sizeof(lines) / sizeof(lines[0]))
+      return 0x7000 | ((r >> 8) & 0x0eff);   /* moveq */
+   if (pick > sizeof(lines) / sizeof(lines[0]))
+      return 0x2000 | ((r >> 8) & 0x0e07);   /* move.l dy,dx */
+   return lines[pick] | ((r >> 8) & 0x0fc7);
+}
+
+static void build(uint32_t seed)
+{
+   uint32_t a;
+
+   rng = seed * 2654435761u + 1;
+   for (a = 0; a < RAM_SIZE; a += 2)
+      put16(a, next_random());
+
+   /* Stack, then every vector back into the code */
+   put32(0, 0x00007ff0u);
+   put32(4, CODE_BASE);
+   for (a = 8; a < CODE_BASE; a += 4)
+      put32(a, CODE_BASE + (next_random() & 0x7ffeu));
+
+   /* moveq #-1,d7; jmp loop; loop: body; dbra d7,loop */
+   put16(CODE_BASE, 0x7eff);
+   put16(CODE_BASE + 2, 0x4ef9);
+   put32(CODE_BASE + 4, LOOP_BASE);
+   for (a = LOOP_BASE; a < LOOP_BASE + 16; a += 2)
+      put16(a, register_op() & ~0x0e00u);
+   put16(LOOP_BASE + 16, 0x51cf);
+   put16(LOOP_BASE + 18, (uint32_t)(-18) & 0xffffu);
+
+   for (a = 0; a < SLICES; a++)
+      slice_cycles[a] = 1 + (int)(next_random() % 400);
+}
+
+/* What happens between two slices, before the given one */
+static void between(unsigned slice)
+{
+   if ((slice % 97) == 96)
+      m68k_set_irq(1 + (slice / 97) % 7);
+   else if ((slice % 97) == 0)
+      m68k_set_irq(0);
+   if ((slice % 1000) == 999)
+      m68k_pulse_reset();
+}
+
+static void compare(int used)
+{
+   static unsigned char* context;
+
+   if (!context)
+      context = malloc(context_size);
+   m68k_get_context(context);
+
+   if (!failed && (used != slice_used[current] || memcmp(context, slice_context[current], context_size)))
+   {
+      printf("68000 timeslice chaining: MISMATCH at slice %u\n", current);
+      printf("  cycles %d separate, %d chained\n", slice_used[current], used);
+      failed = 1;
+   }
+}
+
+static int next_slice(int cycles_used)
+{
+   compare(cycles_used);
+   ended = 1;
+
+   if (++current == SLICES || failed)
+      return 0;
+
+   between(current);
+   return slice_cycles[current];
+}
+
+/* nop; nop; move.b d0,END_PORT; bra * - 24 cycles up to the end of the
+   write, whatever the slice was */
+static int end_timeslice_billed(void)
+{
+   static const int slices[] = { 100, 1000, 100000 };
+   unsigned i;
+
+   put16(CODE_BASE, 0x4e71);
+   put16(CODE_BASE + 2, 0x4e71);
+   put16(CODE_BASE + 4, 0x13c0);
+   put32(CODE_BASE + 6, END_PORT);
+   put16(CODE_BASE + 10, 0x60fe);
+   m68k_set_timeslice_callback(NULL);
+
+   for (i = 0; i < sizeof(slices) / sizeof(slices[0]); i++)
+   {
+      int used;
+
+      m68k_invalidate_code(0, 0x1000000);
+      m68k_pulse_reset();
+      m68k_execute(0);
+      used = m68k_execute(slices[i]);
+      if (used != 24)
+      {
+         printf("68000 timeslice chaining: a slice of %d ended by a write billed %d cycles, not 24\n",
+                slices[i], used);
+         return 0;
+      }
+   }
+
+   return 1;
+}
+
+int main(void)
+{
+   static uint8_t ram_start[RAM_SIZE];
+   static uint8_t ram_separate[RAM_SIZE];
+   unsigned char* start;
+   unsigned long entries = 0;
+   unsigned seed;
+   unsigned page;
+   unsigned i;
+
+   m68k_init();
+   m68k_set_cpu_type(M68K_CPU_TYPE_68000);
+
+   for (page = 0; page < RAM_SIZE / M68K_PAGE_SIZE; page++)
+   {
+      m68k_set_read_page(page, &ram[page * M68K_PAGE_SIZE]);
+      m68k_set_write_page(page, &ram[page * M68K_PAGE_SIZE]);
+   }
+   m68k_set_block_cache(1);
+
+   context_size = m68k_context_size();
+   start = malloc(context_size);
+   for (i = 0; i < SLICES; i++)
+      slice_context[i] = malloc(context_size);
+
+   for (seed = 1; seed <= SEEDS; seed++)
+   {
+      build(seed);
+      m68k_invalidate_code(0, 0x1000000);
+      m68k_pulse_reset();
+      m68k_get_context(start);
+      memcpy(ram_start, ram, RAM_SIZE);
+
+      /* One call a slice */
+      m68k_set_timeslice_callback(NULL);
+      for (i = 0; i < SLICES; i++)
+      {
+         between(i);
+         slice_used[i] = m68k_execute(slice_cycles[i]);
+         m68k_get_context(slice_context[i]);
+      }
+      memcpy(ram_separate, ram, RAM_SIZE);
+
+      /* Chained: back in only when the core comes out */
+      m68k_set_context(start);
+      memcpy(ram, ram_start, RAM_SIZE);
+      m68k_invalidate_code(0, 0x1000000);
+      m68k_set_timeslice_callback(next_slice);
+
+      current = 0;
+      between(0);
+      while (current < SLICES && !failed)
+      {
+         int used;
+
+         ended = 0;
+         used = m68k_execute(slice_cycles[current]);
+         entries++;
+
+         /* Came out without ending a slice through the callback */
+         if (!ended)
+         {
+            compare(used);
+            if (++current < SLICES)
+               between(current);
+         }
+      }
+
+      if (!failed && memcmp(ram_separate, ram, RAM_SIZE))
+      {
+         printf("68000 timeslice chaining: MISMATCH in ram\n");
+         failed = 1;
+      }
+      if (failed)
+      {
+         printf("  at seed %u\n", seed);
+         return 1;
+      }
+   }
+
+   if (entries >= (unsigned long)SEEDS * SLICES)
+   {
+      printf("68000 timeslice chaining: the core never went on into a slice\n");
+      return 1;
+   }
+
+   if (!end_timeslice_billed())
+      return 1;
+
+   printf("68000 timeslice chaining: ok (%u seeds, %u slices each, %lu calls for %lu slices)\n",
+          SEEDS, SLICES, entries, (unsigned long)SEEDS * SLICES);
+   return 0;
+}
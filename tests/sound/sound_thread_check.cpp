@@ -0,0 +1,216 @@
+/* Threaded against inline sound for the same Z80 program.
+ *
+ * Runs the whole machine for a fixed number of frames twice from power
+ * on: once with every sound event handled where it is posted, and once
+ * with the Z80 and the YM2610 on the sound thread. The thread is meant
+ * to run exactly the Z80 executions the emulation would have run itself,
+ * in the same order and of the same lengths, so the audio of every frame
+ * has to come out sample for sample the same. The first frame where it
+ * does not is reported.
+ *
+ * The 68000 program, in ROM, sends a command to the Z80 now and then and
+ * reads the reply back. The Z80 program sets up an FM voice, starts both
+ * YM2610 timers and polls for commands, answering each from its NMI. Its
+ * timer interrupt counts the expiries and keys the voice on and off on
+ * timer A, so the audio moves with the timing of every interrupt. The
+ * run fails as well if the Z80 took no interrupt or answered no command,
+ * or the audio is silent, since then there would be nothing to compare.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "3rdparty/musashi/m68k.h"
+#include "3rdparty/ym/ym2610.h"
+#include "3rdparty/z80/z80.h"
+#include "diagnostics.h"
+#include "libretro_common.h"
+#include "neogeocd.h"
+
+#define FRAMES 600
+
+/* Reset vectors, then at 0x400: moveq #0,d0
+   loop: addq.b #1,d0; move.b d0,$320000; move.w #2000,d1; dbra d1,*;
+         move.b $320000,d2; cmp.b d0,d2; beq +2; addq.l #1,d4;
+         addq.l #1,d3; bra loop
+   D3 counts the commands sent and D4 the replies that did not match. */
+static const uint8_t m68kVectors[] = { 0x00, 0x10, 0xF3, 0x00, 0x00, 0xC0, 0x04, 0x00 };
+
+static const uint8_t m68kProgram[] = {
+    0x70, 0x00, 0x52, 0x00, 0x13, 0xC0, 0x00, 0x32, 0x00, 0x00, 0x32, 0x3C, 0x07, 0xD0, 0x51, 0xC9,
+    0xFF, 0xFE, 0x14, 0x39, 0x00, 0x32, 0x00, 0x00, 0xB4, 0x00, 0x67, 0x02, 0x52, 0x84, 0x52, 0x83,
+    0x60, 0xE0
+};
+
+/* 0000: di; ld sp,$F800; im 1; ld hl,$0100
+   init: ld a,(hl); cp $FF; jr z,done; out ($04),a; inc hl; ld a,(hl);
+         out ($05),a; inc hl; jr init
+   done: out ($08),a; ei
+   loop: in a,($00); bit 0,a; jr z,loop; ld a,($F800); inc a;
+         ld ($F800),a; out ($00),a; jr loop */
+static const uint8_t z80Main[] = {
+    0xF3, 0x31, 0x00, 0xF8, 0xED, 0x56, 0x21, 0x00, 0x01, 0x7E, 0xFE, 0xFF, 0x28, 0x09, 0xD3, 0x04,
+    0x23, 0x7E, 0xD3, 0x05, 0x23, 0x18, 0xF2, 0xD3, 0x08, 0xFB, 0xDB, 0x00, 0xCB, 0x47, 0x28, 0xFA,
+    0x3A, 0x00, 0xF8, 0x3C, 0x32, 0x00, 0xF8, 0xD3, 0x00, 0x18, 0xEF
+};
+
+/* 0038: jp $0080 */
+static const uint8_t z80Rst38[] = { 0xC3, 0x80, 0x00 };
+
+/* 0066: push af; in a,($00); out ($0C),a; ld ($F803),a; pop af; retn */
+static const uint8_t z80Nmi[] = {
+    0xF5, 0xDB, 0x00, 0xD3, 0x0C, 0x32, 0x03, 0xF8, 0xF1, 0xED, 0x45
+};
+
+/* 0080: push af; push bc; push hl; in a,($04); ld b,a; bit 0,b; jr z,noA;
+         ld hl,($F810); inc hl; ld ($F810),hl; ld a,l; and 1; ld c,$01;
+         jr z,keyoff; ld c,$F1
+   keyoff: ld a,$28; out ($04),a; ld a,c; out ($05),a
+   noA:  bit 1,b; jr z,noB; ld hl,($F812); inc hl; ld ($F812),hl
+   noB:  ld a,$27; out ($04),a; ld a,$3F; out ($05),a;
+         pop hl; pop bc; pop af; ei; reti */
+static const uint8_t z80Irq[] = {
+    0xF5, 0xC5, 0xE5, 0xDB, 0x04, 0x47, 0xCB, 0x40, 0x28, 0x17, 0x2A, 0x10, 0xF8, 0x23, 0x22, 0x10,
+    0xF8, 0x7D, 0xE6, 0x01, 0x0E, 0x01, 0x28, 0x02, 0x0E, 0xF1, 0x3E, 0x28, 0xD3, 0x04, 0x79, 0xD3,
+    0x05, 0xCB, 0x48, 0x28, 0x07, 0x2A, 0x12, 0xF8, 0x23, 0x22, 0x12, 0xF8, 0x3E, 0x27, 0xD3, 0x04,
+    0x3E, 0x3F, 0xD3, 0x05, 0xE1, 0xC1, 0xF1, 0xFB, 0xED, 0x4D
+};
+
+/* 0100: YM2610 register and value pairs, up to $FF: timer A and B
+   periods, channel 1's operators, frequency, algorithm and panning, and
+   last both timers loaded with their interrupts on */
+static const uint8_t z80Registers[] = {
+    0x24, 0xE7, 0x25, 0x00, 0x26, 0xF8,
+    0x31, 0x01, 0x35, 0x01, 0x39, 0x01, 0x3D, 0x01,
+    0x41, 0x10, 0x45, 0x10, 0x49, 0x10, 0x4D, 0x10,
+    0x51, 0x1F, 0x55, 0x1F, 0x59, 0x1F, 0x5D, 0x1F,
+    0x61, 0x00, 0x65, 0x00, 0x69, 0x00, 0x6D, 0x00, 0x71, 0x00, 0x75, 0x00, 0x79, 0x00, 0x7D, 0x00,
+    0x81, 0x0F, 0x85, 0x0F, 0x89, 0x0F, 0x8D, 0x0F,
+    0xA5, 0x22, 0xA1, 0x69, 0xB1, 0x07, 0xB5, 0xC0,
+    0x27, 0x3F, 0xFF
+};
+
+struct Run
+{
+    std::vector<int16_t>  samples;
+    std::vector<uint32_t> frameEnds;
+    uint32_t              commands;
+    uint32_t              mismatches;
+    uint32_t              timerA;
+    uint32_t              timerB;
+    uint32_t              answered;
+};
+
+static bool environment(unsigned, void*)
+{
+    return false;
+}
+
+static void log(enum retro_log_level, const char*, ...)
+{
+}
+
+static void run(bool threaded, Run& result)
+{
+    neocd = new NeoGeoCD;
+
+    memcpy(neocd->memory.rom, m68kVectors, sizeof(m68kVectors));
+    memcpy(neocd->memory.rom + 0x400, m68kProgram, sizeof(m68kProgram));
+    neocd->initialize();
+    neocd->sound.enable(threaded);
+
+    // The 68000 is one core shared by both runs, and its counters survive a reset
+    m68k_set_reg(M68K_REG_D3, 0);
+    m68k_set_reg(M68K_REG_D4, 0);
+
+    uint8_t* z80Ram = neocd->memory.z80Ram;
+    memcpy(z80Ram, z80Main, sizeof(z80Main));
+    memcpy(z80Ram + 0x38, z80Rst38, sizeof(z80Rst38));
+    memcpy(z80Ram + 0x66, z80Nmi, sizeof(z80Nmi));
+    memcpy(z80Ram + 0x80, z80Irq, sizeof(z80Irq));
+    memcpy(z80Ram + 0x100, z80Registers, sizeof(z80Registers));
+    z80_reset();
+    YM2610Reset();
+
+    // The BIOS would let the Z80 go once it had loaded the driver
+    neocd->z80Disable = false;
+
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        neocd->runOneFrame();
+
+        const auto& buffer = neocd->audio.buffer;
+        for (uint32_t i = 0; i < buffer.sampleCount; ++i)
+        {
+            result.samples.push_back(buffer.ymSamples[i].left);
+            result.samples.push_back(buffer.ymSamples[i].right);
+        }
+        result.frameEnds.push_back(static_cast<uint32_t>(result.samples.size()));
+    }
+
+    result.commands = m68k_get_reg(nullptr, M68K_REG_D3);
+    result.mismatches = m68k_get_reg(nullptr, M68K_REG_D4);
+    result.timerA = z80Ram[0xF810] | (z80Ram[0xF811] << 8);
+    result.timerB = z80Ram[0xF812] | (z80Ram[0xF813] << 8);
+    result.answered = z80Ram[0xF800];
+
+    delete neocd;
+    neocd = nullptr;
+}
+
+int main()
+{
+    libretro.environment = environment;
+    libretro.log = log;
+    Diagnostics::init();
+
+    Run inline_;
+    Run threaded;
+    run(false, inline_);
+    run(true, threaded);
+
+    bool silent = true;
+    for (int16_t sample : inline_.samples)
+        silent = silent && !sample;
+
+    if (!inline_.timerA || !inline_.timerB || !inline_.answered || silent)
+    {
+        printf("sound thread check: the program did nothing to compare "
+               "(timer A %u, timer B %u, commands answered %u, %s)\n",
+               inline_.timerA, inline_.timerB, inline_.answered, silent ? "silent" : "audible");
+        return 1;
+    }
+
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        const uint32_t start = frame ? inline_.frameEnds[frame - 1] : 0;
+        const uint32_t end = inline_.frameEnds[frame];
+        const uint32_t threadedStart = frame ? threaded.frameEnds[frame - 1] : 0;
+        const uint32_t threadedEnd = threaded.frameEnds[frame];
+
+        if ((end - start != threadedEnd - threadedStart) ||
+            memcmp(&inline_.samples[start], &threaded.samples[threadedStart], (end - start) * sizeof(int16_t)))
+        {
+            printf("sound thread check: MISMATCH in frame %d (%u samples inline, %u threaded)\n",
+                   frame, (end - start) / 2, (threadedEnd - threadedStart) / 2);
+            return 1;
+        }
+    }
+
+    if ((inline_.commands != threaded.commands) || (inline_.mismatches != threaded.mismatches) ||
+        (inline_.timerA != threaded.timerA) || (inline_.timerB != threaded.timerB) ||
+        (inline_.answered != threaded.answered))
+    {
+        printf("sound thread check: MISMATCH in the end state "
+               "(commands %u/%u, bad replies %u/%u, timer A %u/%u, timer B %u/%u)\n",
+               inline_.commands, threaded.commands, inline_.mismatches, threaded.mismatches,
+               inline_.timerA, threaded.timerA, inline_.timerB, threaded.timerB);
+        return 1;
+    }
+
+    printf("sound thread check: ok (%d frames, %u samples, timer A %u, timer B %u, %u commands)\n",
+           FRAMES, static_cast<uint32_t>(inline_.samples.size() / 2), inline_.timerA, inline_.timerB,
+           inline_.commands);
+    return 0;
+}
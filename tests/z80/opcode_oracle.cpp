@@ -0,0 +1,233 @@
+/* Differential oracle for the Z80 core.
+ *
+ * Executes every opcode of every prefix table - the 256 plain opcodes,
+ * CB xx, ED xx, DD xx, FD xx, DD CB d xx and FD CB d xx - from an
+ * identical starting state against a bus that answers the same way
+ * forever, once with every flag clear and once with every flag set, so
+ * each conditional instruction goes both ways. Everything the instruction
+ * did - each write, each port read and write, the register file
+ * afterwards, the T-states it billed and any it skipped - is folded into
+ * one digest per encoding. Those digests, and those of taking an NMI and
+ * an interrupt in each of the three modes, are then folded into one
+ * digest for the run, which is what golden holds.
+ *
+ * The bus is stateless on purpose. The core reads its 64KiB straight
+ * from the array handed to z80_set_memory(), which holds a fixed
+ * function of the address and the code window and is never written:
+ * writes are recorded rather than stored, and port reads are a fixed
+ * function of the port. Nothing an encoding does can reach the next
+ * one, so the run has no order dependence and no accumulated state to
+ * explain away.
+ *
+ * A change that is meant to preserve behaviour reproduces the digest.
+ * A change that is meant to alter it - one encoding, say - will not,
+ * and --dump writes the per-encoding lines so two builds can be diffed
+ * to see exactly which encodings moved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "z80.h"
+#include "z80intf.h"
+
+#define CODE_BASE  0x1000u
+#define CODE_SIZE  0x10u
+
+static uint8_t ram[0x10000];
+static uint64_t trace;
+
+static uint64_t mix(uint64_t h, uint64_t v)
+{
+   return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+static void hash_step(uint64_t v)
+{
+   trace = mix(trace, v);
+}
+
+/* Fixed filler so every address outside the code window reads back the
+   same value on every run of every build. */
+static uint8_t filler(uint32_t a)
+{
+   uint32_t h = a * 2654435761u;
+   h ^= h >> 15;
+   return (uint8_t)(h >> 7);
+}
+
+uint16_t io_read_byte_8(uint16_t port)
+{
+   hash_step(0x11u); hash_step(port);
+   return filler(0x10000u + port);
+}
+
+/* Odd ports count as steady, so the poll loop shortcut has both answers */
+int io_read_steady(uint16_t port)
+{
+   return port & 1;
+}
+
+/* Writes are recorded, never stored: the trace is the observable. */
+void io_write_byte_8(uint16_t port, uint16_t value)
+{
+   hash_step(0x81u); hash_step(port); hash_step(value);
+}
+
+void program_write_byte_8(uint16_t addr, uint8_t value)
+{
+   hash_step(0x82u); hash_step(addr); hash_step(value);
+}
+
+int z80_irq_callback(int parameter)
+{
+   hash_step(0xacu); hash_step((uint32_t)parameter);
+   return 0x38;
+}
+
+/* Every register starts the same for every encoding, flags apart */
+static void set_state(uint8_t flags)
+{
+   z80_reset();
+   Z80.pc.d  = CODE_BASE;
+   Z80.sp.d  = 0x8000;
+   Z80.af.d  = 0x5a00 | flags;
+   Z80.bc.d  = 0x0203;
+   Z80.de.d  = 0x4567;
+   Z80.hl.d  = 0x6789;
+   Z80.ix.d  = 0x789a;
+   Z80.iy.d  = 0x89ab;
+   Z80.af2.d = 0x9abc;
+   Z80.bc2.d = 0xabcd;
+   Z80.de2.d = 0xbcde;
+   Z80.hl2.d = 0xcdef;
+   Z80.i     = 0x3f;
+   Z80.r     = 0x12;
+   Z80.r2    = 0x80;
+   Z80.iff1  = 1;
+   Z80.iff2  = 1;
+   Z80.im    = 1;
+   Z80.halt  = 0;
+   z80_set_irq_line(INPUT_LINE_NMI, CLEAR_LINE);
+   z80_set_irq_line(0, CLEAR_LINE);
+   z80_idle_cycles = 0;
+}
+
+/* One instruction's worth from the state set up, and what it did */
+static int run_one(void)
+{
+   int cycles;
+
+   trace  = 0xcbf29ce484222325ULL;
+   cycles = z80_execute(1);
+
+   hash_step(Z80.prvpc.d); hash_step(Z80.pc.d); hash_step(Z80.sp.d);
+   hash_step(Z80.af.d); hash_step(Z80.bc.d); hash_step(Z80.de.d);
+   hash_step(Z80.hl.d); hash_step(Z80.ix.d); hash_step(Z80.iy.d);
+   hash_step(Z80.af2.d); hash_step(Z80.bc2.d); hash_step(Z80.de2.d);
+   hash_step(Z80.hl2.d);
+   hash_step(Z80.r); hash_step(Z80.r2); hash_step(Z80.i);
+   hash_step(Z80.iff1); hash_step(Z80.iff2); hash_step(Z80.im);
+   hash_step(Z80.halt); hash_step(Z80.after_ei);
+   hash_step((uint32_t)z80_idle_cycles);
+
+   return cycles;
+}
+
+static const char* const prefix_names[] = {
+   "", "cb", "ed", "dd", "fd", "ddcb", "fdcb"
+};
+
+#define PREFIX_COUNT (sizeof(prefix_names) / sizeof(prefix_names[0]))
+
+/* The bytes at the code window for opcode op of the prefix table,
+   then a fixed pattern, so any encoding that takes a displacement or
+   an immediate takes the same ones every time. */
+static void put_code(unsigned prefix, unsigned op)
+{
+   static const uint8_t lead[PREFIX_COUNT][2] = {
+      { 0, 0 }, { 0xcb, 0 }, { 0xed, 0 }, { 0xdd, 0 }, { 0xfd, 0 },
+      { 0xdd, 0xcb }, { 0xfd, 0xcb }
+   };
+   unsigned at = 0;
+   unsigned i;
+
+   for (i = 0; i < CODE_SIZE; i++)
+      ram[CODE_BASE + i] = (uint8_t)(0x40 + i * 7);
+
+   if (lead[prefix][0])
+      ram[CODE_BASE + at++] = lead[prefix][0];
+   if (lead[prefix][1])
+      ram[CODE_BASE + at++] = lead[prefix][1];
+   /* DD CB and FD CB take the displacement before the opcode */
+   if (lead[prefix][1])
+      at++;
+   ram[CODE_BASE + at] = (uint8_t)op;
+}
+
+int main(int argc, char** argv)
+{
+   uint64_t run  = 0xcbf29ce484222325ULL;
+   int      dump = (argc > 1 && !strcmp(argv[1], "--dump"));
+   unsigned prefix;
+   unsigned op;
+   unsigned pass;
+   unsigned i;
+
+   for (i = 0; i < sizeof(ram); i++)
+      ram[i] = filler(i);
+
+   z80_init(0, 4000000, NULL, z80_irq_callback);
+   z80_set_memory(ram);
+
+   for (prefix = 0; prefix < PREFIX_COUNT; prefix++)
+   {
+      for (op = 0; op < 0x100; op++)
+      {
+         put_code(prefix, op);
+
+         for (pass = 0; pass < 2; pass++)
+         {
+            int cycles;
+
+            set_state(pass ? 0xff : 0x00);
+            cycles = run_one();
+
+            if (dump)
+               printf("%-4s %02x %c %3d %016llx\n", prefix_names[prefix], op,
+                      pass ? 'F' : '-', cycles, (unsigned long long)trace);
+
+            run = mix(run, trace);
+            run = mix(run, (uint64_t)(int64_t)cycles);
+         }
+      }
+   }
+
+   /* An NMI, then an interrupt in each mode, taken before a NOP */
+   for (i = 0; i < 4; i++)
+   {
+      int cycles;
+
+      put_code(0, 0x00);
+      set_state(0x00);
+      if (i == 0)
+         z80_set_irq_line(INPUT_LINE_NMI, ASSERT_LINE);
+      else
+      {
+         Z80.im = (uint8_t)(i - 1);
+         z80_set_irq_line(0, ASSERT_LINE);
+      }
+      cycles = run_one();
+
+      if (dump)
+         printf("%-4s %02x %c %3d %016llx\n", i ? "irq" : "nmi", i ? i - 1 : 0,
+                '-', cycles, (unsigned long long)trace);
+
+      run = mix(run, trace);
+      run = mix(run, (uint64_t)(int64_t)cycles);
+   }
+
+   if (!dump)
+      printf("%016llx\n", (unsigned long long)run);
+   return 0;
+}
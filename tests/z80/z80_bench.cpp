@@ -0,0 +1,245 @@
+/* Throughput benchmark for the Z80 core.
+ *
+ * Runs one long straight-line program - 8192 instructions drawn at
+ * random from the plain, CB, ED, DD and DD CB tables: loads, ALU
+ * operations on registers, immediates and memory, rotates, shifts, bit
+ * operations, block transfer steps and port accesses - then an INC IY
+ * counting the passes and a JP back. Nothing in it branches, stacks or
+ * repeats, so every pass is the same instructions, and with that many
+ * the dispatch is exercised the way a sound driver does, not the way a
+ * loop round a few instructions would.
+ *
+ * Writes are counted and dropped, as the oracle's are, so the program
+ * can write wherever HL and IX point without overwriting itself.
+ *
+ * It prints millions of instructions per second. The digest of the
+ * registers and the writes is there to compare two builds by: a change
+ * to the dispatch must leave it alone.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "z80.h"
+#include "z80intf.h"
+
+#define LENGTH     8192
+
+static uint8_t ram[0x10000];
+static uint32_t rng = 2463534242u;
+static uint64_t writes = 0xcbf29ce484222325ULL;
+
+uint16_t io_read_byte_8(uint16_t port)
+{
+   return (uint8_t)(port * 0x9d);
+}
+
+int io_read_steady(uint16_t port)
+{
+   (void)port;
+   return 0;
+}
+
+void io_write_byte_8(uint16_t port, uint16_t value)
+{
+   writes = (writes ^ ((uint32_t)port << 8 | value)) * 0x100000001b3ULL;
+}
+
+void program_write_byte_8(uint16_t addr, uint8_t value)
+{
+   writes = (writes ^ ((uint32_t)addr << 8 | value)) * 0x100000001b3ULL;
+}
+
+int z80_irq_callback(int parameter)
+{
+   (void)parameter;
+   return 0x38;
+}
+
+static uint32_t next_random(void)
+{
+   rng ^= rng << 13;
+   rng ^= rng >> 17;
+   rng ^= rng << 5;
+   return rng;
+}
+
+/* Plain opcodes that neither branch nor touch SP or IY, beyond the
+   LD and ALU blocks; plain_length() gives how many bytes each takes */
+static const uint8_t plain_ops[] = {
+   0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c,
+   0x0d, 0x0e, 0x0f, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x19, 0x1a,
+   0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+   0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x32, 0x34, 0x35, 0x36, 0x37,
+   0x39, 0x3a, 0x3c, 0x3d, 0x3e, 0x3f, 0xc6, 0xce, 0xd3, 0xd6, 0xd9, 0xdb,
+   0xde, 0xe6, 0xeb, 0xee, 0xf6, 0xfe
+};
+
+static unsigned plain_length(uint8_t op)
+{
+   switch (op)
+   {
+      case 0x01: case 0x11: case 0x21: case 0x22: case 0x2a: case 0x32:
+      case 0x3a:
+         return 3;
+      case 0x06: case 0x0e: case 0x16: case 0x1e: case 0x26: case 0x2e:
+      case 0x36: case 0x3e: case 0xc6: case 0xce: case 0xd3: case 0xd6:
+      case 0xdb: case 0xde: case 0xe6: case 0xee: case 0xf6: case 0xfe:
+         return 2;
+      default:
+         return 1;
+   }
+}
+
+/* ED opcodes of the same kind: port and 16-bit arithmetic, NEG, the
+   interrupt mode and I/R moves, RRD/RLD, and single block steps */
+static const uint8_t ed_ops[] = {
+   0x40, 0x41, 0x42, 0x44, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4f, 0x50, 0x51,
+   0x52, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5e, 0x5f, 0x60, 0x61, 0x62, 0x67,
+   0x68, 0x69, 0x6a, 0x6f, 0x78, 0x79, 0xa0, 0xa1, 0xa2, 0xa3, 0xa8, 0xa9,
+   0xaa, 0xab
+};
+
+/* DD opcodes on IX and (IX+d), none of which touch SP or IY */
+static const uint8_t dd_ops[] = {
+   0x09, 0x19, 0x24, 0x25, 0x26, 0x2c, 0x2d, 0x2e, 0x34, 0x35, 0x36, 0x44,
+   0x45, 0x46, 0x4c, 0x4d, 0x4e, 0x54, 0x55, 0x56, 0x5c, 0x5d, 0x5e, 0x60,
+   0x61, 0x62, 0x63, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6e, 0x6f, 0x70,
+   0x71, 0x72, 0x73, 0x74, 0x75, 0x77, 0x7c, 0x7d, 0x7e, 0x84, 0x85, 0x86,
+   0x8c, 0x8d, 0x8e, 0x94, 0x95, 0x96, 0x9c, 0x9d, 0x9e, 0xa4, 0xa5, 0xa6,
+   0xac, 0xad, 0xae, 0xb4, 0xb5, 0xb6, 0xbc, 0xbd, 0xbe
+};
+
+/* Whether the DD opcode takes a displacement, and an immediate after it */
+static unsigned dd_length(uint8_t op)
+{
+   if (op == 0x36)
+      return 4;
+   if (op == 0x26 || op == 0x2e || op == 0x34 || op == 0x35
+    || (op >= 0x70 && op <= 0x77) || ((op & 0x07) == 0x06 && op >= 0x40))
+      return 3;
+   return 2;
+}
+
+/* Appends one random instruction at a, returning the address after it */
+static uint32_t put_instruction(uint32_t a)
+{
+   const uint32_t r = next_random();
+   unsigned length;
+   uint8_t op;
+   unsigned i;
+
+   switch ((r >> 24) % 10)
+   {
+      case 0:
+      case 1:
+      case 2:   /* LD r,r' and LD r,(HL) and LD (HL),r */
+         op = (uint8_t)(0x40 + (r & 0x3f));
+         if (op == 0x76)
+            op = 0x7e;
+         ram[a] = op;
+         return a + 1;
+      case 3:
+      case 4:   /* ALU A with r or (HL) */
+         ram[a] = (uint8_t)(0x80 + (r & 0x3f));
+         return a + 1;
+      case 5:
+         op = plain_ops[r % sizeof(plain_ops)];
+         length = plain_length(op);
+         ram[a] = op;
+         for (i = 1; i < length; i++)
+            ram[a + i] = (uint8_t)next_random();
+         return a + length;
+      case 6:
+         ram[a] = 0xcb;
+         ram[a + 1] = (uint8_t)r;
+         return a + 2;
+      case 7:
+         ram[a] = 0xed;
+         ram[a + 1] = ed_ops[r % sizeof(ed_ops)];
+         return a + 2;
+      case 8:
+         op = dd_ops[r % sizeof(dd_ops)];
+         length = dd_length(op);
+         ram[a] = 0xdd;
+         ram[a + 1] = op;
+         for (i = 2; i < length; i++)
+            ram[a + i] = (uint8_t)next_random();
+         return a + length;
+      default:
+         ram[a] = 0xdd;
+         ram[a + 1] = 0xcb;
+         ram[a + 2] = (uint8_t)next_random();
+         ram[a + 3] = (uint8_t)r;
+         return a + 4;
+   }
+}
+
+static uint64_t digest(void)
+{
+   uint64_t h = writes;
+   const uint32_t regs[] = {
+      Z80.pc.d, Z80.sp.d, Z80.af.d, Z80.bc.d, Z80.de.d, Z80.hl.d,
+      Z80.ix.d, Z80.iy.d, Z80.af2.d, Z80.bc2.d, Z80.de2.d, Z80.hl2.d,
+      Z80.i, Z80.r, Z80.im
+   };
+   unsigned i;
+
+   for (i = 0; i < sizeof(regs) / sizeof(regs[0]); i++)
+      h = (h ^ regs[i]) * 0x100000001b3ULL;
+
+   return h;
+}
+
+int main(int argc, char** argv)
+{
+   const long long cycles = (argc > 1) ? atoll(argv[1]) * 1000000 : 400000000;
+   double instructions = 0;
+   double seconds;
+   clock_t start;
+   uint32_t a = 0;
+   uint16_t passes;
+   long long i;
+
+   /* The program: body; inc iy; jp 0 */
+   for (i = 0; i < LENGTH; i++)
+      a = put_instruction(a);
+   ram[a + 0] = 0xfd;
+   ram[a + 1] = 0x23;
+   ram[a + 2] = 0xc3;
+   ram[a + 3] = 0x00;
+   ram[a + 4] = 0x00;
+
+   z80_init(0, 4000000, NULL, z80_irq_callback);
+   z80_set_memory(ram);
+   z80_reset();
+   Z80.sp.d = 0xfff0;
+   Z80.iy.d = 0;
+   passes = 0;
+
+   start = clock();
+   for (i = 0; i < cycles / 100000; i++)
+   {
+      /* IY wraps at 65536 passes; no call runs anywhere near that many */
+      z80_execute(100000);
+      instructions += (double)(uint16_t)(Z80.iy.w.l - passes) * (LENGTH + 2);
+      passes = Z80.iy.w.l;
+   }
+   seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+   if (instructions <= 0)
+      instructions = 1;
+
+   printf("%-14s %.1f Minstructions/s  digest %016llx\n",
+#if Z80_COMPUTED_GOTO
+          "computed goto",
+#else
+          "switch",
+#endif
+          instructions / 1e6 / (seconds > 0 ? seconds : 1e-9),
+          (unsigned long long)digest());
+
+   return 0;
+}